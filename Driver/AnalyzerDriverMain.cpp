@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "BatchAnalyzer.h"
+#include "../Lexer/TokenSpecification/TokenSpecReader.h"
+#include "../Lexer/DFA/LexerDFABuilder.h"
+#include "../Lexer/DFA/DFACache.h"
+#include "../Parser/Reader/GrammarReader.h"
+#include "../Parser/Table/LR1TableBuilder.h"
+
+/**
+ * @brief Анализ множества файлов: DFA (и LR-таблица) строятся один раз, файлы
+ *        обрабатываются в --jobs потоках, результаты печатаются в порядке файлов.
+ *
+ * Файлы читаются как есть, без препроцессора.
+ */
+
+static void printUsage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " <token_specs.txt> <file|directory|@list.txt>... [--jobs N]"
+            << " [--grammar=<file>] [--dfa-cache=<dir>] [--dump-tokens]\n";
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  std::string specsFile = argv[1];
+  std::vector<std::string> inputs;
+  std::string grammarFile;
+  std::string cacheDir;
+  BatchAnalyzer::Options options;
+  for (int i = 2; i < argc; i++) {
+    std::string opt = argv[i];
+    const std::string jobsPrefix = "--jobs=";
+    const std::string grammarPrefix = "--grammar=";
+    const std::string cachePrefix = "--dfa-cache=";
+    std::string jobs;
+    if (opt == "--jobs" || opt == "-j") {
+      if (i + 1 >= argc) {
+        printUsage(argv[0]);
+        return 1;
+      }
+      jobs = argv[++i];
+    } else if (opt.rfind(jobsPrefix, 0) == 0) {
+      jobs = opt.substr(jobsPrefix.size());
+    } else if (opt.rfind(grammarPrefix, 0) == 0) {
+      grammarFile = opt.substr(grammarPrefix.size());
+    } else if (opt.rfind(cachePrefix, 0) == 0) {
+      cacheDir = opt.substr(cachePrefix.size());
+    } else if (opt == "--dump-tokens") {
+      options.dumpTokens = true;
+    } else if (opt.rfind("--", 0) == 0) {
+      std::cerr << "Unknown option: " << opt << std::endl;
+      return 1;
+    } else {
+      inputs.push_back(opt);
+    }
+    if (!jobs.empty()) {
+      try {
+        options.jobs = static_cast<unsigned>(std::stoul(jobs));
+      } catch (const std::exception &) {
+        std::cerr << "Invalid job count: " << jobs << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  std::vector<TokenSpec> specs;
+  std::vector<std::string> files;
+  DFA dfa;
+  std::optional<Grammar> grammar;
+  std::optional<LRTable> table;
+  try {
+    TokenSpecReader tsReader;
+    specs = tsReader.readTokenSpecs(specsFile);
+    sortTokenSpecsByPriority(specs);
+    std::optional<DFACache> cache;
+    std::optional<DFA> cached;
+    if (!cacheDir.empty()) {
+      cache.emplace(cacheDir);
+      cached = cache->load(specs);
+    }
+    if (cached) {
+      dfa = std::move(*cached);
+    } else {
+      LexerDFABuilder dfaBuilder;
+      dfa = dfaBuilder.build(specs);
+      if (cache) {
+        cache->store(specs, dfa);
+      }
+    }
+    if (!grammarFile.empty()) {
+      GrammarReader grammarReader;
+      grammar = grammarReader.readGrammar(grammarFile);
+      LR1TableBuilder tableBuilder;
+      table = tableBuilder.build(*grammar);
+    }
+    files = BatchAnalyzer::collectInputs(inputs);
+  } catch (const std::exception &e) {
+    std::cerr << "Setup error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  BatchAnalyzer analyzer(dfa, specs, options,
+                         grammar ? &*grammar : nullptr,
+                         table ? &*table : nullptr);
+  size_t failed = 0;
+  size_t totalTokens = 0;
+  auto start = std::chrono::steady_clock::now();
+  analyzer.run(files, [&](const FileReport &report) {
+      totalTokens += report.tokens;
+      std::cout << report.tokenDump;
+      std::cout << report.path << ": tokens=" << report.tokens
+                << " unknown=" << report.unknownTokens
+                << " symbols=" << report.symbols;
+      if (report.parsed) {
+        std::cout << " parse=ok";
+      }
+      if (!report.error.empty()) {
+        std::cout << " error=" << report.error;
+        failed++;
+      }
+      std::cout << "\n";
+  });
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cerr << files.size() << " files, " << totalTokens << " tokens, " << failed << " failed, "
+            << ms << " ms\n";
+  return failed == 0 ? 0 : 2;
+}
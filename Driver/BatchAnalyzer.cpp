@@ -0,0 +1,212 @@
+#include "BatchAnalyzer.h"
+#include "../Lexer/ILexer.h"
+#include "../Lexer/DfaLexer.h"
+#include "../Lexer/Reader/MmapReader.h"
+#include "../SymbolTable/SymbolTable.h"
+#include "../Parser/LRParser.h"
+#include "../Parser/Table/LR1TableBuilder.h"
+#include "../Parser/AST/ASTBuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Лексер файла, собирающий статистику для FileReport.
+ *
+ * Для LRParser отдаёт END_OF_FILE под именем маркера конца ввода LR-таблицы.
+ */
+class ReportingLexer : public ILexer {
+public:
+    ReportingLexer(DfaLexer &lexer, FileReport &report, bool dumpTokens)
+            : m_lexer(lexer),
+              m_report(report),
+              m_dumpTokens(dumpTokens) {}
+
+    /**
+     * @brief Следующий компактный токен с учётом в отчёте.
+     */
+    CompactToken next() {
+      CompactToken tok = m_lexer.getNextCompactToken();
+      if (tok.typeId == CompactToken::END_OF_FILE_TYPE) {
+        return tok;
+      }
+      m_report.tokens++;
+      if (tok.typeId == CompactToken::UNKNOWN_TYPE) {
+        m_report.unknownTokens++;
+      }
+      if (tok.symbolId >= 0) {
+        m_report.symbols = std::max(m_report.symbols, static_cast<size_t>(tok.symbolId) + 1);
+      }
+      if (m_dumpTokens) {
+        m_report.tokenDump += "Type: " + m_lexer.typeName(tok.typeId) +
+                              ", Lexeme: '" + std::string(tok.lexeme) +
+                              "', Line: " + std::to_string(tok.line) +
+                              ", Col: " + std::to_string(tok.column) + "\n";
+      }
+      return tok;
+    }
+
+    Token getNextToken() override {
+      CompactToken tok = next();
+      if (tok.typeId == CompactToken::END_OF_FILE_TYPE) {
+        return {LR1TableBuilder::END_OF_INPUT, "", tok.line, tok.column};
+      }
+      return m_lexer.toToken(tok);
+    }
+
+private:
+    DfaLexer &m_lexer;
+    FileReport &m_report;
+    bool m_dumpTokens;
+};
+
+BatchAnalyzer::BatchAnalyzer(const DFA &dfa,
+                             const std::vector<TokenSpec> &tokenSpecs,
+                             Options options,
+                             const Grammar *grammar,
+                             const LRTable *table)
+        : m_dfa(dfa),
+          m_tokenSpecs(tokenSpecs),
+          m_options(options),
+          m_grammar(grammar),
+          m_table(table),
+          m_accel(dfa, tokenSpecs)
+{
+  if (m_grammar && !m_table) {
+    throw std::runtime_error("BatchAnalyzer: grammar requires an LR table");
+  }
+  if (m_grammar) {
+    m_augmentedGrammar = LR1TableBuilder::augmentGrammar(*m_grammar);
+  }
+  if (m_options.jobs == 0) {
+    m_options.jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+FileReport BatchAnalyzer::analyzeFile(const std::string &path) const
+{
+  FileReport report;
+  report.path = path;
+  try {
+    MmapReader reader(path);
+    SymbolTable symbols;
+    DfaLexer lexer(m_dfa, m_tokenSpecs, m_accel, reader, &symbols);
+    ReportingLexer reporting(lexer, report, m_options.dumpTokens);
+    if (m_grammar) {
+      ASTBuilder astBuilder;
+      LRParser parser(&reporting, *m_table, m_augmentedGrammar, &astBuilder);
+      parser.parse();
+      report.parsed = true;
+    } else {
+      while (reporting.next().typeId != CompactToken::END_OF_FILE_TYPE) {
+      }
+    }
+  } catch (const std::exception &e) {
+    report.error = e.what();
+  }
+  return report;
+}
+
+void BatchAnalyzer::run(const std::vector<std::string> &files,
+                        const std::function<void(const FileReport &)> &emit) const
+{
+  const size_t count = files.size();
+  std::atomic<size_t> nextFile{0};
+  std::mutex doneMutex;
+  std::vector<std::optional<FileReport>> done(count);
+  size_t emitted = 0;
+  bool emitting = false;   ///< Какой-то поток сейчас выдаёт отчёты (под doneMutex)
+
+  auto worker = [&] {
+      for (;;) {
+        size_t i = nextFile.fetch_add(1);
+        if (i >= count) {
+          return;
+        }
+        FileReport report = analyzeFile(files[i]);
+        {
+          std::lock_guard<std::mutex> lock(doneMutex);
+          done[i] = std::move(report);
+          // Отчёт заберёт поток, который уже выдаёт: он проверит готовый префикс
+          // ещё раз, прежде чем сбросить emitting
+          if (emitting) {
+            continue;
+          }
+          emitting = true;
+        }
+        // Выдаём готовый префикс вне блокировки: emit не задерживает остальные потоки,
+        // а порядок отчётов не зависит от порядка завершения
+        std::vector<FileReport> ready;
+        for (;;) {
+          {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            while (emitted < count && done[emitted]) {
+              ready.push_back(std::move(*done[emitted]));
+              done[emitted].reset();
+              emitted++;
+            }
+            if (ready.empty()) {
+              emitting = false;
+              break;
+            }
+          }
+          for (const auto &r : ready) {
+            emit(r);
+          }
+          ready.clear();
+        }
+      }
+  };
+
+  size_t threadCount = std::min<size_t>(m_options.jobs, count);
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < threadCount; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+std::vector<std::string> BatchAnalyzer::collectInputs(const std::vector<std::string> &args)
+{
+  namespace fs = std::filesystem;
+  std::vector<std::string> files;
+  for (const auto &arg : args) {
+    if (!arg.empty() && arg[0] == '@') {
+      std::ifstream list(arg.substr(1));
+      if (!list) {
+        throw std::runtime_error("Failed to open file list: " + arg.substr(1));
+      }
+      std::string line;
+      while (std::getline(list, line)) {
+        if (!line.empty() && line.back() == '\r') {
+          line.pop_back();
+        }
+        if (!line.empty()) {
+          files.push_back(line);
+        }
+      }
+    } else if (fs::is_directory(arg)) {
+      std::vector<std::string> found;
+      for (const auto &entry : fs::recursive_directory_iterator(arg)) {
+        if (entry.is_regular_file()) {
+          found.push_back(entry.path().string());
+        }
+      }
+      std::sort(found.begin(), found.end());
+      files.insert(files.end(), found.begin(), found.end());
+    } else {
+      files.push_back(arg);
+    }
+  }
+  return files;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "../Lexer/DFA/DFA.h"
+#include "../Lexer/DFA/DFAAccelerator.h"
+#include "../Lexer/TokenSpecification/TokenSpec.h"
+#include "../Parser/Grammar/Grammar.h"
+#include "../Parser/Table/LRTable.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Результат анализа одного файла.
+ */
+struct FileReport {
+    std::string path;
+    size_t tokens = 0;          ///< Токены без END_OF_FILE
+    size_t unknownTokens = 0;   ///< Из них UNKNOWN
+    size_t symbols = 0;         ///< Различные идентификаторы (записи таблицы символов файла)
+    bool parsed = false;        ///< Разбор по грамматике прошёл успешно
+    std::string error;          ///< Ошибка чтения или разбора; пусто — ошибок нет
+    std::string tokenDump;      ///< Токены в формате main, если включён dumpTokens
+};
+
+/**
+ * @brief Анализ множества файлов в нескольких потоках.
+ *
+ * DFA, ускоритель его петель и (если задана грамматика) LR-таблица строятся один раз
+ * и во время run() только читаются всеми потоками. Всё изменяемое — ридер, DfaLexer,
+ * таблица символов, LRParser и ASTBuilder — у каждого файла своё, поэтому результат
+ * файла не зависит от того, какой поток и в каком порядке его обработал.
+ *
+ * Потоки берут файлы из общей очереди по одному (динамическая балансировка: большие
+ * и маленькие файлы перемешаны). Отчёты выдаются строго в порядке списка файлов:
+ * отчёт файла i отдаётся, как только готовы отчёты всех файлов до него.
+ */
+class BatchAnalyzer {
+public:
+    struct Options {
+        unsigned jobs = 0;          ///< Число потоков; 0 — std::thread::hardware_concurrency()
+        bool dumpTokens = false;    ///< Сохранять токены файла в FileReport::tokenDump
+    };
+
+    /**
+     * @param dfa Автомат лексера
+     * @param tokenSpecs Спецификации токенов (в порядке typeId автомата)
+     * @param options Параметры запуска
+     * @param grammar Грамматика для разбора или nullptr (только лексический анализ)
+     * @param table LR-таблица для grammar (обязательна вместе с grammar)
+     * @throws std::runtime_error Если grammar задана без table.
+     */
+    BatchAnalyzer(const DFA &dfa,
+                  const std::vector<TokenSpec> &tokenSpecs,
+                  Options options,
+                  const Grammar *grammar = nullptr,
+                  const LRTable *table = nullptr);
+
+    /**
+     * @brief Анализирует files и вызывает emit для каждого отчёта в порядке files.
+     *
+     * emit вызывается из рабочих потоков, но никогда одновременно.
+     * Ошибки отдельных файлов попадают в FileReport::error и не прерывают обработку.
+     */
+    void run(const std::vector<std::string> &files,
+             const std::function<void(const FileReport &)> &emit) const;
+
+    /**
+     * @brief Анализ одного файла в вызывающем потоке.
+     */
+    [[nodiscard]] FileReport analyzeFile(const std::string &path) const;
+
+    /**
+     * @brief Разворачивает аргументы командной строки в список файлов:
+     *  - каталог — все обычные файлы в нём рекурсивно, в лексикографическом порядке путей;
+     *  - @list.txt — пути из файла, по одному в строке (пустые строки пропускаются);
+     *  - иначе аргумент считается путём к файлу.
+     * @throws std::runtime_error Если файл со списком не открывается.
+     */
+    static std::vector<std::string> collectInputs(const std::vector<std::string> &args);
+
+private:
+    const DFA &m_dfa;
+    const std::vector<TokenSpec> &m_tokenSpecs;
+    Options m_options;
+    const Grammar *m_grammar;
+    const LRTable *m_table;
+    /// Пополненная грамматика для LRParser: в таблице LR1TableBuilder номера продукций
+    /// отсчитываются с добавленной нулевой продукции S' -> start
+    Grammar m_augmentedGrammar;
+    DFAAccelerator m_accel;   ///< Общий для лексеров всех потоков
+};
@@ -0,0 +1,30 @@
+#include "BasicDfaLexer.h"
+
+#include <stdexcept>
+
+static const std::string UNKNOWN_TYPE_NAME = "UNKNOWN";
+static const std::string END_OF_FILE_TYPE_NAME = "END_OF_FILE";
+
+int checkedIdentTypeId(const std::vector<TokenSpec> &tokenSpecs)
+{
+  if (tokenSpecs.size() > CompactToken::MAX_SPEC_COUNT) {
+    throw std::runtime_error("Слишком много спецификаций токенов: " + std::to_string(tokenSpecs.size()));
+  }
+  for (size_t i = 0; i < tokenSpecs.size(); i++) {
+    if (tokenSpecs[i].name == "IDENT") {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+const std::string &tokenTypeName(const std::vector<TokenSpec> &tokenSpecs, uint16_t typeId)
+{
+  if (typeId < tokenSpecs.size()) {
+    return tokenSpecs[typeId].name;
+  }
+  if (typeId == CompactToken::END_OF_FILE_TYPE) {
+    return END_OF_FILE_TYPE_NAME;
+  }
+  return UNKNOWN_TYPE_NAME;
+}
@@ -0,0 +1,476 @@
+#pragma once
+#include "ILexer.h"
+#include "DFA/DFAAccelerator.h"
+#include "Token/CompactToken.h"
+#include "Token/TokenStream.h"
+#include "TokenSpecification/TokenSpec.h"
+#include "Reader/IReader.h"
+#include "../SymbolTable/ISymbolTable.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Проверяет число спецификаций и возвращает typeId спецификации IDENT (или -1).
+ * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
+ */
+int checkedIdentTypeId(const std::vector<TokenSpec> &tokenSpecs);
+
+/**
+ * @brief Имя типа токена по typeId: имя спецификации, "UNKNOWN" или "END_OF_FILE".
+ */
+const std::string &tokenTypeName(const std::vector<TokenSpec> &tokenSpecs, uint16_t typeId);
+
+/**
+ * @brief Цикл разбора на токены по детерминированному автомату, общий для DfaLexer
+ *        (таблица DFA), LazyDfaLexer (LazyDFA) и StaticDfaLexer (таблица, построенная
+ *        при компиляции).
+ *
+ * Automaton — лёгкий адаптер автомата, хранимый по значению:
+ *  - int start() const — стартовое состояние;
+ *  - int next(int state, unsigned char c) const — переход или -1;
+ *  - int token(int state) const — токен допускающего состояния или -1;
+ *  - size_t stateCount() const — число состояний (для ключей мемоизации);
+ *  - static constexpr bool STABLE_STATE_IDS — номера состояний не меняются за время
+ *    жизни автомата (нужно для setLinearTime()).
+ *
+ * Правило самого длинного совпадения: автомат идёт до тупика, затем ридер откатывается
+ * (IReader::mark()/reset()) к концу последнего допущенного префикса, и символы после него
+ * достаются следующему токену. Если не допущен ни один префикс, возвращается
+ * односимвольный UNKNOWN. Ридер с окнами должен поддерживать reset() в пределах токена.
+ * Ридер без окон (window() пуст) читается наперёд через peekChar(), и из него забирается
+ * только допущенный префикс, поэтому reset() ему не нужен (кроме спецификаций,
+ * допускающих байт '\0', — см. getNextCompactToken()).
+ *
+ * Если передан DFAAccelerator (он строится по той же таблице, номера состояний совпадают),
+ * игнорируемые токены вида «байт + петля» пропускаются векторным сканером до обхода
+ * автомата, а серии байтов внутри ускоряемых состояний проходятся сканером.
+ */
+template <typename Automaton>
+class BasicDfaLexer : public ILexer {
+public:
+    /**
+     * @see ILexer::getNextToken
+     */
+    Token getNextToken() override {
+      return toToken(getNextCompactToken());
+    }
+
+    /**
+     * @brief Возвращает следующий токен в компактном виде.
+     *
+     * Если ридер отдаёт стабильные окна (hasStableWindows()), лексема ссылается прямо
+     * на его буфер и живёт столько же, сколько ридер. Иначе лексема лежит во внутреннем
+     * буфере лексера и действительна до следующего вызова.
+     */
+    CompactToken getNextCompactToken();
+
+    /**
+     * @brief Ленивые позиции: токены получают только offset, line и column остаются 0,
+     *        и лексер не спрашивает позицию у ридера. Строку и столбец потребитель
+     *        вычисляет по смещению через LineIndex (MmapReader::lineIndex(),
+     *        TwoBufferReader::lineIndex() или LineIndex по буферу входа) — только для
+     *        тех токенов, которым они нужны.
+     */
+    void setLazyPositions(bool lazy) { m_lazyPositions = lazy; }
+
+    /**
+     * @brief Гарантия линейного времени (мемоизация Репса).
+     *
+     * Без неё откат к последнему допуску может давать квадратичное время: для спецификаций
+     * «a» и «a*b» на входе «aaa…a» каждый токен сканирует вход до конца и откатывается.
+     * С ней лексер запоминает пары (состояние, смещение), пройденные после последнего
+     * допуска, — из них допуск недостижим, — и следующий токен, попав в такую пару,
+     * сразу останавливается. Каждая пара сканируется впустую не больше одного раза.
+     *
+     * Пока откатов нет, память не расходуется и быстрый путь не меняется; байты токена,
+     * начавшегося в области запомненных пар, проходятся по одному без ускорителя петель.
+     */
+    void setLinearTime(bool enabled) requires Automaton::STABLE_STATE_IDS {
+      m_linearTime = enabled;
+      m_failed.clear();
+      m_failedEnd = 0;
+    }
+
+    /**
+     * @brief Смещение за самым дальним байтом, который автомат просмотрел с создания лексера
+     *        (включая байт, на котором он остановился, и «просмотр» конца входа).
+     *
+     * Токены, полученные, пока scanReach() <= o, не зависят от байтов начиная с o:
+     * по этому признаку инкрементальный лексер находит токены, задетые правкой.
+     */
+    [[nodiscard]] uint64_t scanReach() const { return m_scanReach; }
+
+    /**
+     * @brief Дописывает в out не больше maxTokens следующих токенов (END_OF_FILE не пишется).
+     *
+     * Для ридера со стабильными окнами лексемы в потоке ссылаются на его буфер
+     * (out.source), иначе копируются в out.text.
+     * @return Сколько токенов добавлено; 0 — вход закончился.
+     */
+    size_t tokenizeBatch(TokenStream &out, size_t maxTokens);
+
+    /**
+     * @brief Дописывает в out все оставшиеся токены.
+     * @return Сколько токенов добавлено.
+     */
+    size_t tokenizeAll(TokenStream &out) {
+      return tokenizeBatch(out, std::numeric_limits<size_t>::max());
+    }
+
+    /**
+     * @brief Преобразует компактный токен в Token (копирует имя типа и лексему).
+     */
+    [[nodiscard]] Token toToken(const CompactToken &token) const {
+      return {typeName(token.typeId), std::string(token.lexeme), token.line, token.column, token.symbolId};
+    }
+
+    /**
+     * @brief Имя типа токена по его typeId.
+     */
+    [[nodiscard]] const std::string &typeName(uint16_t typeId) const {
+      return tokenTypeName(m_tokenSpecs, typeId);
+    }
+
+protected:
+    /**
+     * @param automaton Адаптер автомата
+     * @param tokenSpecs Набор спецификаций токенов
+     * @param accel Ускоритель, построенный по той же таблице, или nullptr
+     * @param reader Источник символов
+     * @param symbolTable Указатель на таблицу символов (может быть nullptr)
+     * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
+     */
+    BasicDfaLexer(Automaton automaton,
+                  const std::vector<TokenSpec> &tokenSpecs,
+                  const DFAAccelerator *accel,
+                  IReader &reader,
+                  ISymbolTable *symbolTable)
+            : m_automaton(automaton),
+              m_tokenSpecs(tokenSpecs),
+              m_reader(reader),
+              m_symbolTable(symbolTable),
+              m_identTypeId(checkedIdentTypeId(tokenSpecs)),
+              m_accel(accel)
+    {}
+
+    Automaton m_automaton;
+    const std::vector<TokenSpec> &m_tokenSpecs;
+    IReader &m_reader;
+    ISymbolTable *m_symbolTable;
+    int m_identTypeId;                 ///< typeId спецификации IDENT (или -1), для таблицы символов
+    const DFAAccelerator *m_accel;     ///< Сканеры петель и состояния пропуска (или nullptr)
+
+private:
+    std::string m_lexeme;      ///< Буфер лексемы для ридеров без стабильных окон
+    bool m_lazyPositions = false;
+    uint64_t m_scanReach = 0;
+    bool m_linearTime = false;
+    std::unordered_set<uint64_t> m_failed;   ///< Пары без достижимого допуска: смещение * число состояний + состояние
+    uint64_t m_failedEnd = 0;                ///< Все пары m_failed лежат на смещениях меньше этого
+
+    /**
+     * @brief Запоминает пары, пройденные после последнего допуска: автомат из state
+     *        на смещении from прошёл байты tail.
+     */
+    void rememberFailures(int state, uint64_t from, std::string_view tail);
+
+    /**
+     * @brief Пропускает подряд идущие игнорируемые токены, у которых есть состояние пропуска.
+     */
+    void skipIgnoredRuns();
+};
+
+template <typename Automaton>
+size_t BasicDfaLexer<Automaton>::tokenizeBatch(TokenStream &out, size_t maxTokens)
+{
+  if (out.empty() && out.text.empty() && !out.source && m_reader.hasStableWindows()) {
+    // Стабильные окна — части одного буфера со всем входом: лексемы берём из него
+    std::span<const char> w = m_reader.window();
+    if (!w.empty()) {
+      out.source = w.data() - m_reader.getOffset();
+    }
+  }
+  size_t added = 0;
+  while (added < maxTokens) {
+    CompactToken tok = getNextCompactToken();
+    if (tok.typeId == CompactToken::END_OF_FILE_TYPE) {
+      break;
+    }
+    out.push(tok);
+    added++;
+  }
+  return added;
+}
+
+template <typename Automaton>
+void BasicDfaLexer<Automaton>::rememberFailures(int state, uint64_t from, std::string_view tail)
+{
+  const auto stateCount = static_cast<uint64_t>(m_automaton.stateCount());
+  uint64_t pos = from;
+  for (char c : tail) {
+    state = m_automaton.next(state, (unsigned char)c);
+    pos++;
+    if (!m_failed.insert(pos * stateCount + static_cast<uint64_t>(state)).second) {
+      // Пара уже известна — её продолжение по тем же байтам запомнено вместе с ней
+      break;
+    }
+  }
+  m_failedEnd = std::max(m_failedEnd, pos + 1);
+}
+
+template <typename Automaton>
+void BasicDfaLexer<Automaton>::skipIgnoredRuns()
+{
+  if (!m_accel) {
+    return;
+  }
+  for (;;) {
+    std::span<const char> w = m_reader.window();
+    if (w.empty()) {
+      return;
+    }
+    int state = m_accel->skipState(static_cast<unsigned char>(w[0]));
+    if (state == -1) {
+      return;
+    }
+    const ByteSetScanner &scanner = m_accel->loopScanner(state);
+    size_t n = 1 + scanner.span(w.data() + 1, w.size() - 1);
+    m_reader.advance(n);
+    // Серия дошла до конца окна — автомат всё ещё в state, продолжаем её в следующем окне
+    while (n == w.size()) {
+      w = m_reader.window();
+      if (w.empty()) {
+        return;
+      }
+      n = scanner.span(w.data(), w.size());
+      m_reader.advance(n);
+    }
+  }
+}
+
+template <typename Automaton>
+CompactToken BasicDfaLexer<Automaton>::getNextCompactToken()
+{
+  // Игнорируемые токены пропускаются циклом, а не рекурсией: длинная серия
+  // пробелов и комментариев не расходует стек
+  for (;;) {
+    skipIgnoredRuns();
+    CompactToken tok;
+    tok.offset = m_reader.getOffset();
+    if (!m_lazyPositions) {
+      tok.line = m_reader.getLine();
+      tok.column = m_reader.getColumn();
+    }
+    if (m_reader.isEOF()) {
+      m_scanReach = std::max(m_scanReach, tok.offset + 1);
+      tok.typeId = CompactToken::END_OF_FILE_TYPE;
+      return tok;
+    }
+    m_reader.mark();
+
+    // Запомненные пары нужны, только пока токен может до них дойти
+    bool memo = false;
+    if (m_linearTime && !m_failed.empty()) {
+      if (tok.offset + 1 >= m_failedEnd) {
+        m_failed.clear();
+      } else {
+        memo = true;
+      }
+    }
+    const auto stateCount = static_cast<uint64_t>(m_automaton.stateCount());
+
+    const Automaton automaton = m_automaton;
+    int currentState = automaton.start();
+    int lastAcceptState = -1;
+    int lastAcceptIndex = -1;
+    // Сколько символов просмотрено с начала токена, сколько из них забрано из ридера
+    // и длина самого длинного допущенного префикса
+    size_t length = 0;
+    size_t consumed = 0;
+    size_t acceptLength = 0;
+
+    // Лексема либо ссылается на стабильное окно ридера (view), либо копируется в m_lexeme
+    const bool stable = m_reader.hasStableWindows();
+    const char *viewBegin = nullptr;
+    size_t viewSize = 0;
+    bool copied = !stable;
+    m_lexeme.clear();
+
+    bool dead = false;
+    while (!dead) {
+      // Пока есть просмотренные, но не забранные символы, окно начиналось бы не там
+      std::span<const char> w = consumed == length ? m_reader.window() : std::span<const char>();
+      if (w.empty()) {
+        // Ридер не отдаёт окон (или вход кончился) — посимвольный путь: символы только
+        // просматриваются, а из ридера забирается лишь допущенный префикс
+        if (m_reader.isEOF()) {
+          break;
+        }
+        const size_t ahead = length - consumed;
+        char c = m_reader.peekChar(static_cast<int>(ahead));
+        if (ahead == 0 && m_reader.isEOF()) {
+          break;
+        }
+        int nextState = automaton.next(currentState, (unsigned char)c);
+        if (nextState == -1) {
+          break;
+        }
+        if (c == '\0' && ahead > 0) {
+          // За концом входа peekChar(ahead) тоже отдаёт '\0', а автомат по нему идёт:
+          // забираем просмотренное, чтобы peekChar(0) отличил байт '\0' от конца входа.
+          // Только здесь ридеру без окон может понадобиться reset()
+          for (; consumed < length; consumed++) {
+            m_reader.getChar();
+          }
+          continue;
+        }
+        if (!copied) {
+          m_lexeme.assign(viewBegin, viewSize);
+          copied = true;
+        }
+        m_lexeme.push_back(c);
+        length++;
+        currentState = nextState;
+        if (memo && m_failed.count((tok.offset + length) * stateCount + static_cast<uint64_t>(currentState))) {
+          break;
+        }
+        if (int token = automaton.token(currentState); token != -1) {
+          lastAcceptState = currentState;
+          lastAcceptIndex = token;
+          acceptLength = length;
+        }
+        continue;
+      }
+
+      // Быстрый путь: автомат идёт по непрерывному окну без виртуальных вызовов на байт
+      const char *begin = w.data();
+      const char *end = begin + w.size();
+      const char *p = begin;
+      if (memo) {
+        while (p < end) {
+          // Шаг с проверкой запомненных пар: попав в пару без допуска, дальше не идём
+          int nextState = automaton.next(currentState, (unsigned char)*p);
+          if (nextState == -1) {
+            dead = true;
+            break;
+          }
+          ++p;
+          currentState = nextState;
+          uint64_t pos = tok.offset + length + static_cast<uint64_t>(p - begin);
+          if (m_failed.count(pos * stateCount + static_cast<uint64_t>(currentState))) {
+            dead = true;
+            break;
+          }
+          if (int token = automaton.token(currentState); token != -1) {
+            lastAcceptState = currentState;
+            lastAcceptIndex = token;
+            acceptLength = length + static_cast<size_t>(p - begin);
+          }
+        }
+      } else if (m_accel) {
+        const uint8_t *flags = m_accel->stateFlags();
+        while (p < end) {
+          int nextState = automaton.next(currentState, (unsigned char)*p);
+          if (nextState == -1) {
+            dead = true;
+            break;
+          }
+          ++p;
+          currentState = nextState;
+          if (uint8_t f = flags[currentState]) {
+            if (f & DFAAccelerator::LOOP) {
+              // Пока байты лежат в петле, автомат остаётся в currentState
+              p += m_accel->loopScanner(currentState).span(p, static_cast<size_t>(end - p));
+            }
+            if (f & DFAAccelerator::ACCEPT) {
+              lastAcceptState = currentState;
+              lastAcceptIndex = automaton.token(currentState);
+              acceptLength = length + static_cast<size_t>(p - begin);
+            }
+          }
+        }
+      } else {
+        while (p < end) {
+          int nextState = automaton.next(currentState, (unsigned char)*p);
+          if (nextState == -1) {
+            dead = true;
+            break;
+          }
+          ++p;
+          currentState = nextState;
+          if (int token = automaton.token(currentState); token != -1) {
+            lastAcceptState = currentState;
+            lastAcceptIndex = token;
+            acceptLength = length + static_cast<size_t>(p - begin);
+          }
+        }
+      }
+      if (!copied && (viewSize == 0 || viewBegin + viewSize == begin)) {
+        if (viewSize == 0) {
+          viewBegin = begin;
+        }
+        viewSize += static_cast<size_t>(p - begin);
+      } else {
+        if (!copied) {
+          m_lexeme.assign(viewBegin, viewSize);
+          copied = true;
+        }
+        m_lexeme.append(begin, p);
+      }
+      length += static_cast<size_t>(p - begin);
+      consumed = length;
+      m_reader.advance(static_cast<size_t>(p - begin));
+    }
+
+    // Автомат остановился на байте tok.offset + length (или на конце входа)
+    m_scanReach = std::max(m_scanReach, tok.offset + length + 1);
+
+    if (m_linearTime && length > acceptLength) {
+      std::string_view consumed = copied ? std::string_view(m_lexeme) : std::string_view(viewBegin, viewSize);
+      rememberFailures(lastAcceptIndex == -1 ? automaton.start() : lastAcceptState,
+                       tok.offset + acceptLength, consumed.substr(acceptLength));
+    }
+
+    if (lastAcceptIndex == -1) {
+      // Ни один префикс не допущен: символы, забранные автоматом, возвращаем ридеру
+      if (consumed > 0) {
+        m_reader.reset(tok.offset);
+      }
+      char bad = m_reader.getChar();
+      if (bad == '\0' && m_reader.isEOF()) {
+        tok.typeId = CompactToken::END_OF_FILE_TYPE;
+        return tok;
+      }
+      m_lexeme.assign(1, bad);
+      tok.typeId = CompactToken::UNKNOWN_TYPE;
+      tok.lexeme = m_lexeme;
+      return tok;
+    }
+    if (consumed > acceptLength) {
+      // Автомат ушёл дальше последнего допускающего состояния — откат к нему
+      m_reader.reset(tok.offset + acceptLength);
+    }
+    for (; consumed < acceptLength; consumed++) {
+      m_reader.getChar();
+    }
+
+    if (m_tokenSpecs[lastAcceptIndex].ignore) {
+      continue;
+    }
+
+    tok.typeId = static_cast<uint16_t>(lastAcceptIndex);
+    tok.lexeme = copied ? std::string_view(m_lexeme.data(), acceptLength)
+                        : std::string_view(viewBegin, acceptLength);
+    if (lastAcceptIndex == m_identTypeId && m_symbolTable) {
+      tok.symbolId = m_symbolTable->addSymbol(std::string(tok.lexeme));
+    }
+    return tok;
+  }
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include "DFA.h"
+#include "DFAMinimization.h"
+#include "SubsetConstruction.h"
+#include "../NFA/ThompsonArena.h"
+#include "../Regex/RegexGrammar.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Спецификация токена, известная на этапе компиляции.
+ *        Приоритет задаётся порядком в массиве: при равной длине совпадения побеждает
+ *        спецификация с меньшим индексом (как у DfaLexer с отсортированными TokenSpec).
+ */
+struct StaticTokenSpec {
+    std::string_view name;
+    std::string_view regex;
+    bool ignore;
+};
+
+/**
+ * @brief Построение DFA на этапе компиляции тем же конвейером, что и во время выполнения:
+ *        RegexGrammar с ThompsonArena (вместо RegexParser -> ThompsonNFABuilder),
+ *        buildSubsetDFA (SubsetConstructionDFABuilder) и minimizeDFA (DFAMinimizer).
+ *
+ * Результат совпадает с DFA, построенным во время выполнения из тех же спецификаций.
+ * Ошибка в выражении при вычислении на этапе компиляции становится ошибкой компиляции.
+ */
+class ConstexprDFABuilder {
+public:
+    /**
+     * @brief Строит объединённый NFA; индексы токенов — позиции в specs.
+     * @throws std::runtime_error При ошибке в регулярном выражении.
+     */
+    static constexpr NFA buildNFA(std::span<const StaticTokenSpec> specs) {
+      ThompsonArena arena;
+      int start = arena.addState();
+      for (size_t i = 0; i < specs.size(); i++) {
+        ThompsonArena::Fragment f = RegexGrammar<ThompsonArena>(arena, specs[i].regex).parse();
+        arena.setAccept(f.accept, static_cast<int>(i));
+        arena.addEpsilon(start, f.start);
+      }
+      return arena.pack(start, -1);
+    }
+
+    /**
+     * @brief Строит минимальный DFA; индексы токенов — позиции в specs.
+     * @throws std::runtime_error При ошибке в регулярном выражении.
+     */
+    static constexpr DFA build(std::span<const StaticTokenSpec> specs) {
+      return minimizeDFA(buildSubsetDFA(buildNFA(specs)));
+    }
+};
+
+/**
+ * @brief DFA фиксированного размера для размещения в .rodata.
+ *        Тип номера состояния — наименьший знаковый, вмещающий StateCount (-1 — нет перехода).
+ */
+template <size_t StateCount, size_t ClassCount>
+struct StaticDFA {
+    using StateId = std::conditional_t<(StateCount < 0x7fff), int16_t, int32_t>;
+
+    static constexpr size_t STATE_COUNT = StateCount;
+    static constexpr size_t CLASS_COUNT = ClassCount;
+
+    int startState = 0;
+    std::array<uint8_t, 256> classOf{};
+    std::array<StateId, StateCount * ClassCount> transitions{};
+    std::array<int32_t, StateCount> acceptToken{};   ///< Индекс токена или -1
+
+    /**
+     * @brief Переход из состояния state по байту c (или -1).
+     */
+    [[nodiscard]] constexpr int next(int state, unsigned char c) const {
+      return transitions[static_cast<size_t>(state) * ClassCount + classOf[c]];
+    }
+
+    /**
+     * @brief Копия в виде обычного DFA (для DfaLexer, DFAFileWriter и т.п.).
+     */
+    [[nodiscard]] DFA toDFA() const {
+      DFA dfa;
+      dfa.startState = startState;
+      dfa.classCount = static_cast<int>(ClassCount);
+      dfa.classOf = classOf;
+      for (int32_t token : acceptToken) {
+        dfa.states.push_back({token != -1, token});
+      }
+      dfa.transitions.assign(transitions.begin(), transitions.end());
+      return dfa;
+    }
+};
+
+/**
+ * @brief Снимок DFA в массивах фиксированной ёмкости. В отличие от DFA (std::vector) его можно
+ *        хранить в constexpr-переменной, поэтому makeStaticDFA строит автомат один раз.
+ *        Если автомат не поместился (fits == false), размеры всё равно записаны точно.
+ */
+template <size_t MaxStates, size_t ClassCount>
+struct ConstexprDFASnapshot {
+    bool fits = false;
+    size_t stateCount = 0;
+    int startState = 0;
+    std::array<uint8_t, 256> classOf{};
+    std::array<int32_t, MaxStates * ClassCount> transitions{};
+    std::array<int32_t, MaxStates> acceptToken{};
+};
+
+/**
+ * @brief Число классов байтов, которое получит DFA спецификаций (минимизация классы не меняет).
+ */
+template <const auto &Specs>
+consteval size_t staticDFAClassCount() {
+  NFA nfa = ConstexprDFABuilder::buildNFA(Specs);
+  std::array<uint8_t, 256> classOf{};
+  return nfa.states.empty() ? 1 : static_cast<size_t>(computeByteClasses(nfa, classOf));
+}
+
+/**
+ * @brief Оценка числа состояний минимального DFA сверху для типичных лексических спецификаций —
+ *        число состояний NFA Томпсона (без гарантии: см. ConstexprDFASnapshot::fits).
+ */
+template <const auto &Specs>
+consteval size_t staticDFAStateCapacity() {
+  return ConstexprDFABuilder::buildNFA(Specs).states.size() + 1;
+}
+
+/**
+ * @brief Строит DFA спецификаций и копирует его в снимок.
+ */
+template <size_t MaxStates, size_t ClassCount>
+constexpr ConstexprDFASnapshot<MaxStates, ClassCount> snapshotDFA(std::span<const StaticTokenSpec> specs) {
+  DFA dfa = ConstexprDFABuilder::build(specs);
+  ConstexprDFASnapshot<MaxStates, ClassCount> snapshot;
+  snapshot.stateCount = dfa.states.size();
+  snapshot.fits = dfa.states.size() <= MaxStates && static_cast<size_t>(dfa.classCount) == ClassCount;
+  if (!snapshot.fits) {
+    return snapshot;
+  }
+  snapshot.startState = dfa.startState;
+  snapshot.classOf = dfa.classOf;
+  std::copy(dfa.transitions.begin(), dfa.transitions.end(), snapshot.transitions.begin());
+  for (size_t i = 0; i < dfa.states.size(); i++) {
+    snapshot.acceptToken[i] = dfa.states[i].tokenIndex;
+  }
+  return snapshot;
+}
+
+/**
+ * @brief StaticDFA из первых StateCount состояний снимка.
+ */
+template <size_t StateCount, size_t MaxStates, size_t ClassCount>
+constexpr StaticDFA<StateCount, ClassCount> staticDFAFromSnapshot(
+        const ConstexprDFASnapshot<MaxStates, ClassCount> &snapshot) {
+  StaticDFA<StateCount, ClassCount> table;
+  using StateId = typename StaticDFA<StateCount, ClassCount>::StateId;
+  table.startState = snapshot.startState;
+  table.classOf = snapshot.classOf;
+  for (size_t i = 0; i < StateCount * ClassCount; i++) {
+    table.transitions[i] = static_cast<StateId>(snapshot.transitions[i]);
+  }
+  for (size_t i = 0; i < StateCount; i++) {
+    table.acceptToken[i] = snapshot.acceptToken[i];
+  }
+  return table;
+}
+
+/**
+ * @brief Строит StaticDFA по массиву спецификаций на этапе компиляции.
+ *
+ * Specs — constexpr-массив StaticTokenSpec со статическим временем жизни, например:
+ *   static constexpr std::array<StaticTokenSpec, 2> SPECS = {{ {"IDENT", "[a-z]+", false}, ... }};
+ *   static constexpr auto TABLE = makeStaticDFA<SPECS>();
+ *
+ * Автомат строится один раз в снимок с ёмкостью по оценке staticDFAStateCapacity (дёшево:
+ * только NFA), и таблица точного размера копируется из него. Если оценка не хватила,
+ * DFA строится второй раз в снимок уже точного размера.
+ */
+template <const auto &Specs>
+consteval auto makeStaticDFA() {
+  constexpr size_t classCount = staticDFAClassCount<Specs>();
+  constexpr auto estimated = snapshotDFA<staticDFAStateCapacity<Specs>(), classCount>(Specs);
+  if constexpr (estimated.fits) {
+    return staticDFAFromSnapshot<estimated.stateCount>(estimated);
+  } else {
+    constexpr auto exact = snapshotDFA<estimated.stateCount, classCount>(Specs);
+    return staticDFAFromSnapshot<estimated.stateCount>(exact);
+  }
+}
@@ -1,19 +1,36 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 /**
  * @brief Состояние детерминированного конечного автомата (DFA).
+ *        Переходы хранятся в общей таблице DFA::transitions.
  */
 struct DfaState {
-    int transitions[256];
     bool isAccept;
     int tokenIndex;
 };
 
 /**
  * @brief Структура детерминированного конечного автомата (DFA).
+ *
+ * Алфавит сжат до классов эквивалентности байтов: байты, по которым любое состояние
+ * NFA переходит одинаково, попадают в один класс (classOf). Таблица переходов —
+ * плоский массив states.size() * classCount, -1 означает отсутствие перехода.
  */
 struct DFA {
     std::vector<DfaState> states;
-    int startState;
+    int startState = 0;
+    int classCount = 1;
+    std::array<uint8_t, 256> classOf{};
+    std::vector<int> transitions;
+
+    /**
+     * @brief Переход из состояния state по байту c (или -1).
+     */
+    [[nodiscard]] constexpr int next(int state, unsigned char c) const {
+      return transitions[static_cast<size_t>(state) * classCount + classOf[c]];
+    }
 };
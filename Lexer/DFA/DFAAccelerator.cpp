@@ -0,0 +1,197 @@
+#include "DFAAccelerator.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DFA_ACCEL_X86 1
+#else
+#define DFA_ACCEL_X86 0
+#endif
+
+SimdLevel detectSimdLevel() {
+#if DFA_ACCEL_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::SSE2;
+  }
+#endif
+  return SimdLevel::Scalar;
+}
+
+ByteSetScanner::ByteSetScanner(const std::array<bool, 256> &set, SimdLevel level)
+        : m_set(set),
+          m_kind(Kind::Table),
+          m_level(level) {
+  size_t exits = 0;
+  size_t ranges = 0;
+  for (int c = 0; c < 256; c++) {
+    if (!set[c]) {
+      if (exits < MAX_EXITS) {
+        m_exits[exits] = static_cast<uint8_t>(c);
+      }
+      exits++;
+    } else if (c == 0 || !set[c - 1]) {
+      int hi = c;
+      while (hi + 1 < 256 && set[hi + 1]) {
+        hi++;
+      }
+      if (ranges < MAX_RANGES) {
+        m_rangeLo[ranges] = static_cast<uint8_t>(c);
+        m_rangeWidth[ranges] = static_cast<uint8_t>(hi - c);
+      }
+      ranges++;
+    }
+  }
+  if (exits <= MAX_EXITS) {
+    m_kind = Kind::Exits;
+    m_exitCount = static_cast<uint8_t>(exits);
+  } else if (ranges <= MAX_RANGES) {
+    m_kind = Kind::Ranges;
+    m_rangeCount = static_cast<uint8_t>(ranges);
+  }
+}
+
+size_t ByteSetScanner::span(const char *p, size_t n) const {
+  if (m_kind == Kind::Table || m_level == SimdLevel::Scalar) {
+    return spanTable(p, n);
+  }
+  if (m_kind == Kind::Exits && m_exitCount == 1) {
+    // Один байт выхода (например, '*' внутри блочного комментария) — это memchr
+    const void *hit = std::memchr(p, m_exits[0], n);
+    return hit ? static_cast<size_t>(static_cast<const char*>(hit) - p) : n;
+  }
+  if (m_kind == Kind::Exits && m_exitCount == 0) {
+    return n;
+  }
+  return m_level == SimdLevel::AVX2 ? spanAvx2(p, n) : spanSse2(p, n);
+}
+
+size_t ByteSetScanner::spanTable(const char *p, size_t n) const {
+  size_t i = 0;
+  while (i < n && m_set[static_cast<unsigned char>(p[i])]) {
+    i++;
+  }
+  return i;
+}
+
+#if DFA_ACCEL_X86
+
+size_t ByteSetScanner::spanSse2(const char *p, size_t n) const {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    unsigned stop;
+    if (m_kind == Kind::Exits) {
+      __m128i hit = _mm_setzero_si128();
+      for (size_t k = 0; k < m_exitCount; k++) {
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(x, _mm_set1_epi8(static_cast<char>(m_exits[k]))));
+      }
+      stop = static_cast<unsigned>(_mm_movemask_epi8(hit));
+    } else {
+      // Байт в [lo, lo + w] <=> (x - lo) беззнаково <= w <=> min(x - lo, w) == x - lo
+      __m128i in = _mm_setzero_si128();
+      for (size_t k = 0; k < m_rangeCount; k++) {
+        __m128i d = _mm_sub_epi8(x, _mm_set1_epi8(static_cast<char>(m_rangeLo[k])));
+        __m128i w = _mm_set1_epi8(static_cast<char>(m_rangeWidth[k]));
+        in = _mm_or_si128(in, _mm_cmpeq_epi8(_mm_min_epu8(d, w), d));
+      }
+      stop = ~static_cast<unsigned>(_mm_movemask_epi8(in)) & 0xFFFFu;
+    }
+    if (stop) {
+      return i + static_cast<size_t>(__builtin_ctz(stop));
+    }
+  }
+  return i + spanTable(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+size_t ByteSetScanner::spanAvx2(const char *p, size_t n) const {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    uint32_t stop;
+    if (m_kind == Kind::Exits) {
+      __m256i hit = _mm256_setzero_si256();
+      for (size_t k = 0; k < m_exitCount; k++) {
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(x, _mm256_set1_epi8(static_cast<char>(m_exits[k]))));
+      }
+      stop = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+    } else {
+      __m256i in = _mm256_setzero_si256();
+      for (size_t k = 0; k < m_rangeCount; k++) {
+        __m256i d = _mm256_sub_epi8(x, _mm256_set1_epi8(static_cast<char>(m_rangeLo[k])));
+        __m256i w = _mm256_set1_epi8(static_cast<char>(m_rangeWidth[k]));
+        in = _mm256_or_si256(in, _mm256_cmpeq_epi8(_mm256_min_epu8(d, w), d));
+      }
+      stop = ~static_cast<uint32_t>(_mm256_movemask_epi8(in));
+    }
+    if (stop) {
+      return i + static_cast<size_t>(__builtin_ctz(stop));
+    }
+  }
+  return i + spanSse2(p + i, n - i);
+}
+
+#else
+
+size_t ByteSetScanner::spanSse2(const char *p, size_t n) const {
+  return spanTable(p, n);
+}
+
+size_t ByteSetScanner::spanAvx2(const char *p, size_t n) const {
+  return spanTable(p, n);
+}
+
+#endif
+
+DFAAccelerator::DFAAccelerator(const DFA &dfa, const std::vector<TokenSpec> &tokenSpecs, SimdLevel level)
+        : m_level(level),
+          m_flags(dfa.states.size(), 0),
+          m_scannerOf(dfa.states.size(), -1) {
+  m_skipState.fill(-1);
+  const int stateCount = static_cast<int>(dfa.states.size());
+  std::vector<bool> pureLoop(dfa.states.size(), false);
+  for (int s = 0; s < stateCount; s++) {
+    const DfaState &st = dfa.states[s];
+    if (st.isAccept) {
+      m_flags[s] |= ACCEPT;
+    }
+    std::array<bool, 256> loop{};
+    size_t loopSize = 0;
+    size_t liveExits = 0;
+    for (int c = 0; c < 256; c++) {
+      int t = dfa.next(s, static_cast<unsigned char>(c));
+      if (t == s) {
+        loop[c] = true;
+        loopSize++;
+      } else if (t != -1) {
+        liveExits++;
+      }
+    }
+    if (loopSize == 0) {
+      continue;
+    }
+    bool ignoreState = st.isAccept && st.tokenIndex >= 0 &&
+                       static_cast<size_t>(st.tokenIndex) < tokenSpecs.size() &&
+                       tokenSpecs[st.tokenIndex].ignore;
+    // Внутри лексемы (непринимающее состояние) ускоряем только «тела» с немногими выходами:
+    // короткие петли идентификаторов и чисел сканер не окупают
+    if (!ignoreState && (st.isAccept || liveExits > ByteSetScanner::MAX_EXITS)) {
+      continue;
+    }
+    m_flags[s] |= LOOP;
+    m_scannerOf[s] = static_cast<int>(m_scanners.size());
+    m_scanners.emplace_back(loop, level);
+    pureLoop[s] = ignoreState && liveExits == 0;
+  }
+  for (int c = 0; c < 256; c++) {
+    int t = dfa.next(dfa.startState, static_cast<unsigned char>(c));
+    if (t >= 0 && pureLoop[t]) {
+      m_skipState[c] = t;
+    }
+  }
+}
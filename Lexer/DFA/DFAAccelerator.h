@@ -0,0 +1,126 @@
+#pragma once
+#include "DFA.h"
+#include "../TokenSpecification/TokenSpec.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Набор векторных инструкций, которым пользуются сканеры байтов.
+ */
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/**
+ * @brief Лучший уровень, доступный на текущем процессоре (проверяется во время выполнения).
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Поиск конца серии байтов из заданного множества (аналог strspn).
+ *
+ * Представление выбирается по множеству:
+ *  - Exits: вне множества не больше трёх байтов — ищем первый из них
+ *    (один байт — memchr, иначе сравнение блоков на равенство);
+ *  - Ranges: множество — не больше восьми диапазонов, для блока проверяется попадание
+ *    каждого байта хотя бы в один диапазон;
+ *  - Table: остальные случаи, побайтовая таблица.
+ */
+class ByteSetScanner {
+public:
+    static constexpr size_t MAX_EXITS = 3;
+    static constexpr size_t MAX_RANGES = 8;
+
+    /**
+     * @param set Множество байтов (set[c] == true — байт c принадлежит множеству)
+     * @param level Уровень SIMD; Scalar — только побайтовая таблица
+     */
+    ByteSetScanner(const std::array<bool, 256> &set, SimdLevel level);
+
+    /**
+     * @brief Длина наибольшего префикса [p, p + n) из байтов множества.
+     */
+    [[nodiscard]] size_t span(const char *p, size_t n) const;
+
+    [[nodiscard]] bool contains(unsigned char c) const { return m_set[c]; }
+
+private:
+    enum class Kind {
+        Exits,
+        Ranges,
+        Table
+    };
+
+    std::array<bool, 256> m_set;
+    Kind m_kind;
+    SimdLevel m_level;
+    uint8_t m_exitCount = 0;
+    uint8_t m_rangeCount = 0;
+    std::array<uint8_t, MAX_EXITS> m_exits{};
+    std::array<uint8_t, MAX_RANGES> m_rangeLo{};
+    std::array<uint8_t, MAX_RANGES> m_rangeWidth{};   ///< hi - lo
+
+    [[nodiscard]] size_t spanTable(const char *p, size_t n) const;
+    [[nodiscard]] size_t spanSse2(const char *p, size_t n) const;
+    [[nodiscard]] size_t spanAvx2(const char *p, size_t n) const;
+};
+
+/**
+ * @brief Ускорение петель DFA для лексера.
+ *
+ * Для состояния q петля — байты, по которым q переходит само в себя. Ускоряются
+ * состояния, принимающие игнорируемый токен (пробелы), и непринимающие состояния,
+ * из которых не больше трёх переходов ведут в другие состояния (тела комментариев
+ * и строк): пока вход лежит в петле, автомат заведомо остаётся в q, и серия
+ * пропускается сканером целиком.
+ *
+ * Кроме того, для каждого байта b вычисляется «состояние пропуска»: если из старта по b
+ * автомат попадает в принимающее игнорируемый токен состояние t, а из t все переходы —
+ * либо петля, либо тупик, то токен, начинающийся с b, — это b и серия петли t.
+ * Такой токен лексер пропускает, не обходя DFA и не собирая лексему.
+ */
+class DFAAccelerator {
+public:
+    static constexpr uint8_t ACCEPT = 1;   ///< Флаг состояния: принимающее
+    static constexpr uint8_t LOOP = 2;     ///< Флаг состояния: есть сканер петли
+
+    /**
+     * @param dfa Автомат (нужные данные копируются, ссылка не сохраняется)
+     * @param tokenSpecs Спецификации токенов (нужен признак ignore)
+     * @param level Уровень SIMD для сканеров
+     */
+    DFAAccelerator(const DFA &dfa, const std::vector<TokenSpec> &tokenSpecs,
+                   SimdLevel level = detectSimdLevel());
+
+    /**
+     * @brief Флаги ACCEPT/LOOP по номеру состояния.
+     */
+    [[nodiscard]] const uint8_t *stateFlags() const { return m_flags.data(); }
+
+    /**
+     * @brief Сканер петли состояния (только для состояний с флагом LOOP).
+     */
+    [[nodiscard]] const ByteSetScanner &loopScanner(int state) const {
+      return m_scanners[static_cast<size_t>(m_scannerOf[state])];
+    }
+
+    /**
+     * @brief Состояние пропуска для первого байта токена, или -1.
+     */
+    [[nodiscard]] int skipState(unsigned char c) const { return m_skipState[c]; }
+
+    [[nodiscard]] size_t acceleratedStates() const { return m_scanners.size(); }
+    [[nodiscard]] SimdLevel level() const { return m_level; }
+
+private:
+    SimdLevel m_level;
+    std::vector<uint8_t> m_flags;
+    std::vector<int> m_scannerOf;
+    std::vector<ByteSetScanner> m_scanners;
+    std::array<int, 256> m_skipState{};
+};
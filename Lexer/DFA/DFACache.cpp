@@ -0,0 +1,56 @@
+#include "DFACache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+static bool sameSpecs(const std::vector<TokenSpec> &a, const std::vector<TokenSpec> &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].name != b[i].name || a[i].regex != b[i].regex ||
+        a[i].ignore != b[i].ignore || a[i].priority != b[i].priority) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DFACache::DFACache(std::string directory)
+        : m_directory(std::move(directory)) {}
+
+std::string DFACache::pathFor(const std::vector<TokenSpec> &specs) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "dfa-%016llx.bin",
+                static_cast<unsigned long long>(hashTokenSpecs(specs)));
+  return (std::filesystem::path(m_directory) / name).string();
+}
+
+std::optional<DFA> DFACache::load(const std::vector<TokenSpec> &specs) const {
+  std::string path = pathFor(specs);
+  std::error_code ec;
+  if (!std::filesystem::exists(path, ec)) {
+    return std::nullopt;
+  }
+  try {
+    DFAFileLoader loader(path);
+    if (loader.specHash() != hashTokenSpecs(specs) || !sameSpecs(loader.tokenSpecs(), specs)) {
+      return std::nullopt;
+    }
+    return loader.toDFA();
+  } catch (const std::runtime_error &) {
+    // Повреждённый файл или старая версия формата — просто перестраиваем автомат
+    return std::nullopt;
+  }
+}
+
+void DFACache::store(const std::vector<TokenSpec> &specs, const DFA &dfa) const {
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+  if (ec) {
+    throw std::runtime_error("Failed to create DFA cache directory: " + m_directory);
+  }
+  DFAFileWriter writer;
+  writer.write(pathFor(specs), dfa, specs);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "DFA.h"
+#include "DFAFile.h"
+#include "../TokenSpecification/TokenSpec.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Каталог скомпилированных DFA на диске, ключ — хэш спецификаций токенов.
+ *
+ * Файл кэша для набора спецификаций называется dfa-<hashTokenSpecs в hex>.bin.
+ * При загрузке сохранённые спецификации сравниваются с запрошенными целиком,
+ * поэтому коллизия хэша или устаревший/повреждённый файл дают промах, а не чужой автомат.
+ */
+class DFACache {
+public:
+    /**
+     * @param directory Каталог кэша (создаётся при первой записи)
+     */
+    explicit DFACache(std::string directory);
+
+    /**
+     * @brief Путь к файлу кэша для данного набора спецификаций.
+     */
+    [[nodiscard]] std::string pathFor(const std::vector<TokenSpec> &specs) const;
+
+    /**
+     * @brief Загружает DFA, построенный по тем же спецификациям (в том же порядке).
+     * @return DFA или std::nullopt, если подходящего файла нет.
+     */
+    [[nodiscard]] std::optional<DFA> load(const std::vector<TokenSpec> &specs) const;
+
+    /**
+     * @brief Сохраняет DFA для данного набора спецификаций.
+     * @throws std::runtime_error Если каталог или файл не удалось создать.
+     */
+    void store(const std::vector<TokenSpec> &specs, const DFA &dfa) const;
+
+private:
+    std::string m_directory;
+};
@@ -0,0 +1,256 @@
+#include "DFAFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::is_trivially_copyable_v<DFAFileHeader>);
+
+static constexpr char DFA_FILE_MAGIC[8] = {'C', 'A', 'D', 'F', 'A', '\r', '\n', '\0'};
+
+/**
+ * @brief Запись одной спецификации: длины строк, приоритет и флаг, затем сами строки.
+ */
+struct SpecRecord {
+    uint32_t nameSize;
+    uint32_t regexSize;
+    int32_t priority;
+    uint8_t ignore;
+    uint8_t reserved[3];
+};
+
+static uint64_t alignUp(uint64_t value) {
+  return (value + 7) & ~uint64_t{7};
+}
+
+static void fnvMix(uint64_t &h, const void *data, size_t size) {
+  const auto *p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 0x100000001b3ULL;
+  }
+}
+
+uint64_t hashTokenSpecs(const std::vector<TokenSpec> &specs) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  uint32_t version = DFA_FILE_VERSION;
+  fnvMix(h, &version, sizeof(version));
+  for (const auto &spec : specs) {
+    // Длины перед строками: ("ab","c") и ("a","bc") дают разные хэши
+    uint32_t sizes[2] = {static_cast<uint32_t>(spec.name.size()), static_cast<uint32_t>(spec.regex.size())};
+    fnvMix(h, sizes, sizeof(sizes));
+    fnvMix(h, spec.name.data(), spec.name.size());
+    fnvMix(h, spec.regex.data(), spec.regex.size());
+    int32_t priority = spec.priority;
+    uint8_t ignore = spec.ignore ? 1 : 0;
+    fnvMix(h, &priority, sizeof(priority));
+    fnvMix(h, &ignore, sizeof(ignore));
+  }
+  return h;
+}
+
+void DFAFileWriter::write(const std::string &path, const DFA &dfa, const std::vector<TokenSpec> &specs) {
+  DFAFileHeader header{};
+  std::memcpy(header.magic, DFA_FILE_MAGIC, sizeof(header.magic));
+  header.version = DFA_FILE_VERSION;
+  header.headerSize = sizeof(DFAFileHeader);
+  header.specHash = hashTokenSpecs(specs);
+  header.stateCount = static_cast<uint32_t>(dfa.states.size());
+  header.classCount = static_cast<uint32_t>(dfa.classCount);
+  header.startState = dfa.startState;
+  header.specCount = static_cast<uint32_t>(specs.size());
+  std::memcpy(header.classOf, dfa.classOf.data(), sizeof(header.classOf));
+
+  std::vector<int32_t> accept(dfa.states.size());
+  for (size_t i = 0; i < dfa.states.size(); i++) {
+    accept[i] = dfa.states[i].isAccept ? dfa.states[i].tokenIndex : -1;
+  }
+  std::vector<int32_t> transitions(dfa.transitions.begin(), dfa.transitions.end());
+  std::string specBytes;
+  for (const auto &spec : specs) {
+    SpecRecord rec{};
+    rec.nameSize = static_cast<uint32_t>(spec.name.size());
+    rec.regexSize = static_cast<uint32_t>(spec.regex.size());
+    rec.priority = spec.priority;
+    rec.ignore = spec.ignore ? 1 : 0;
+    specBytes.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    specBytes += spec.name;
+    specBytes += spec.regex;
+  }
+
+  header.acceptOffset = alignUp(sizeof(DFAFileHeader));
+  header.transitionsOffset = alignUp(header.acceptOffset + accept.size() * sizeof(int32_t));
+  header.specsOffset = alignUp(header.transitionsOffset + transitions.size() * sizeof(int32_t));
+  header.specsSize = specBytes.size();
+  header.fileSize = header.specsOffset + header.specsSize;
+
+  std::string image(header.fileSize, '\0');
+  std::memcpy(image.data(), &header, sizeof(header));
+  std::memcpy(image.data() + header.acceptOffset, accept.data(), accept.size() * sizeof(int32_t));
+  std::memcpy(image.data() + header.transitionsOffset, transitions.data(), transitions.size() * sizeof(int32_t));
+  std::memcpy(image.data() + header.specsOffset, specBytes.data(), specBytes.size());
+
+  std::string tmpPath = path + ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      throw std::runtime_error("Failed to create DFA file: " + tmpPath);
+    }
+    ofs.write(image.data(), static_cast<std::streamsize>(image.size()));
+    if (!ofs) {
+      std::remove(tmpPath.c_str());
+      throw std::runtime_error("Failed to write DFA file: " + tmpPath);
+    }
+  }
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    throw std::runtime_error("Failed to rename DFA file to: " + path);
+  }
+}
+
+DFAFileLoader::DFAFileLoader(const std::string &path)
+        : m_data(nullptr),
+          m_size(0),
+          m_header(nullptr) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open DFA file: " + path);
+  }
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat DFA file: " + path);
+  }
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size < sizeof(DFAFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("DFA file is truncated: " + path);
+  }
+  void *mapped = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    throw std::runtime_error("Failed to mmap DFA file: " + path);
+  }
+  m_data = static_cast<const char*>(mapped);
+  m_header = reinterpret_cast<const DFAFileHeader*>(m_data);
+
+  auto fail = [&](const std::string &what) {
+      ::munmap(const_cast<char*>(m_data), m_size);
+      m_data = nullptr;
+      throw std::runtime_error("Bad DFA file " + path + ": " + what);
+  };
+  const DFAFileHeader &h = *m_header;
+  if (std::memcmp(h.magic, DFA_FILE_MAGIC, sizeof(h.magic)) != 0) {
+    fail("wrong magic");
+  }
+  if (h.version != DFA_FILE_VERSION) {
+    fail("unsupported version " + std::to_string(h.version));
+  }
+  if (h.headerSize != sizeof(DFAFileHeader) || h.fileSize != m_size) {
+    fail("size mismatch");
+  }
+  if (h.stateCount == 0 || h.classCount == 0 || h.classCount > 256 ||
+      h.startState < 0 || static_cast<uint32_t>(h.startState) >= h.stateCount) {
+    fail("bad automaton dimensions");
+  }
+  if (h.acceptOffset > m_size || h.transitionsOffset > m_size ||
+      h.specsOffset > m_size || h.specsSize > m_size) {
+    fail("sections out of bounds");
+  }
+  uint64_t cells = static_cast<uint64_t>(h.stateCount) * h.classCount;
+  if (h.acceptOffset % 8 != 0 || h.transitionsOffset % 8 != 0 ||
+      h.acceptOffset + uint64_t{h.stateCount} * sizeof(int32_t) > h.transitionsOffset ||
+      h.transitionsOffset + cells * sizeof(int32_t) > h.specsOffset ||
+      h.specsOffset + h.specsSize != m_size) {
+    fail("sections out of bounds");
+  }
+  for (uint8_t cls : h.classOf) {
+    if (cls >= h.classCount) {
+      fail("byte class out of range");
+    }
+  }
+  for (int32_t t : transitions()) {
+    if (t < -1 || t >= static_cast<int32_t>(h.stateCount)) {
+      fail("transition out of range");
+    }
+  }
+  for (int32_t token : acceptTokens()) {
+    if (token < -1 || token >= static_cast<int32_t>(h.specCount)) {
+      fail("token index out of range");
+    }
+  }
+  // Проверяем, что записи спецификаций точно заполняют свою секцию
+  uint64_t pos = 0;
+  for (uint32_t i = 0; i < h.specCount; i++) {
+    if (pos + sizeof(SpecRecord) > h.specsSize) {
+      fail("spec table truncated");
+    }
+    SpecRecord rec{};
+    std::memcpy(&rec, m_data + h.specsOffset + pos, sizeof(rec));
+    pos += sizeof(rec) + uint64_t{rec.nameSize} + rec.regexSize;
+    if (pos > h.specsSize) {
+      fail("spec table truncated");
+    }
+  }
+  if (pos != h.specsSize) {
+    fail("spec table size mismatch");
+  }
+}
+
+DFAFileLoader::~DFAFileLoader() {
+  if (m_data) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+std::span<const int32_t> DFAFileLoader::transitions() const {
+  const auto *p = reinterpret_cast<const int32_t*>(m_data + m_header->transitionsOffset);
+  return {p, static_cast<size_t>(m_header->stateCount) * m_header->classCount};
+}
+
+std::span<const int32_t> DFAFileLoader::acceptTokens() const {
+  const auto *p = reinterpret_cast<const int32_t*>(m_data + m_header->acceptOffset);
+  return {p, m_header->stateCount};
+}
+
+DFA DFAFileLoader::toDFA() const {
+  DFA dfa;
+  dfa.startState = m_header->startState;
+  dfa.classCount = static_cast<int>(m_header->classCount);
+  std::memcpy(dfa.classOf.data(), m_header->classOf, sizeof(m_header->classOf));
+  auto accept = acceptTokens();
+  dfa.states.reserve(accept.size());
+  for (int32_t token : accept) {
+    dfa.states.push_back({token >= 0, token});
+  }
+  auto table = transitions();
+  dfa.transitions.assign(table.begin(), table.end());
+  return dfa;
+}
+
+std::vector<TokenSpec> DFAFileLoader::tokenSpecs() const {
+  std::vector<TokenSpec> specs;
+  specs.reserve(m_header->specCount);
+  const char *p = m_data + m_header->specsOffset;
+  for (uint32_t i = 0; i < m_header->specCount; i++) {
+    SpecRecord rec{};
+    std::memcpy(&rec, p, sizeof(rec));
+    p += sizeof(rec);
+    TokenSpec spec;
+    spec.name.assign(p, rec.nameSize);
+    p += rec.nameSize;
+    spec.regex.assign(p, rec.regexSize);
+    p += rec.regexSize;
+    spec.ignore = rec.ignore != 0;
+    spec.priority = rec.priority;
+    specs.push_back(std::move(spec));
+  }
+  return specs;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "DFA.h"
+#include "../TokenSpecification/TokenSpec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @file DFAFile.h
+ * @brief Двоичный формат скомпилированного DFA вместе со спецификациями токенов.
+ *
+ * Файл целиком отображается в память; все секции выровнены на 8 байт и лежат в порядке
+ * «заголовок, токены состояний, таблица переходов, спецификации». Числа хранятся
+ * в порядке байтов машины, на которой файл записан (кэш не переносится между архитектурами).
+ */
+
+/**
+ * @brief Версия формата. Меняется при любом несовместимом изменении раскладки
+ *        или семантики DFA; файлы другой версии загрузчик отвергает.
+ */
+constexpr uint32_t DFA_FILE_VERSION = 1;
+
+/**
+ * @brief Заголовок файла DFA.
+ */
+struct DFAFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t specHash;            ///< hashTokenSpecs() спецификаций, по которым построен DFA
+    uint64_t fileSize;
+    uint32_t stateCount;
+    uint32_t classCount;
+    int32_t startState;
+    uint32_t specCount;
+    uint64_t acceptOffset;        ///< int32[stateCount]: tokenIndex принимающего состояния или -1
+    uint64_t transitionsOffset;   ///< int32[stateCount * classCount]
+    uint64_t specsOffset;         ///< Записи спецификаций, см. DFAFileWriter
+    uint64_t specsSize;
+    uint8_t classOf[256];
+};
+
+/**
+ * @brief 64-битный хэш (FNV-1a) содержимого спецификаций в переданном порядке.
+ *        Порядок важен: индекс спецификации — это номер токена в DFA, поэтому хэшировать
+ *        нужно уже отсортированный по приоритету список, по которому строился автомат.
+ */
+uint64_t hashTokenSpecs(const std::vector<TokenSpec> &specs);
+
+/**
+ * @brief Записывает DFA и спецификации токенов в файл формата DFA_FILE_VERSION.
+ *
+ * Запись идёт во временный файл рядом с целевым, который затем переименовывается,
+ * так что параллельно работающие процессы никогда не видят недописанный файл.
+ */
+class DFAFileWriter {
+public:
+    /**
+     * @param path Путь к создаваемому файлу
+     * @param dfa Автомат
+     * @param specs Спецификации в том порядке, в котором их индексы записаны в DFA
+     * @throws std::runtime_error Если файл не удалось записать.
+     */
+    void write(const std::string &path, const DFA &dfa, const std::vector<TokenSpec> &specs);
+};
+
+/**
+ * @brief Отображает файл DFA в память и проверяет его целостность.
+ *
+ * Таблицы доступны прямо из отображения (transitions(), acceptTokens()); toDFA() собирает
+ * из них обычный DFA для DfaLexer одним копированием.
+ */
+class DFAFileLoader {
+public:
+    /**
+     * @brief Отображает файл и проверяет заголовок, версию и границы секций.
+     * @throws std::runtime_error Если файл не открывается, повреждён или другой версии.
+     */
+    explicit DFAFileLoader(const std::string &path);
+
+    ~DFAFileLoader();
+
+    DFAFileLoader(const DFAFileLoader &) = delete;
+    DFAFileLoader &operator=(const DFAFileLoader &) = delete;
+
+    [[nodiscard]] const DFAFileHeader &header() const { return *m_header; }
+    [[nodiscard]] uint64_t specHash() const { return m_header->specHash; }
+
+    /**
+     * @brief Таблица переходов states * classCount прямо из отображения.
+     */
+    [[nodiscard]] std::span<const int32_t> transitions() const;
+
+    /**
+     * @brief tokenIndex каждого состояния (-1 — непринимающее) прямо из отображения.
+     */
+    [[nodiscard]] std::span<const int32_t> acceptTokens() const;
+
+    /**
+     * @brief Собирает DFA из отображённых таблиц.
+     */
+    [[nodiscard]] DFA toDFA() const;
+
+    /**
+     * @brief Спецификации токенов, сохранённые вместе с DFA.
+     */
+    [[nodiscard]] std::vector<TokenSpec> tokenSpecs() const;
+
+private:
+    const char *m_data;
+    size_t m_size;
+    const DFAFileHeader *m_header;
+};
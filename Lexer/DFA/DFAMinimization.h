@@ -0,0 +1,221 @@
+#pragma once
+#include "DFA.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * @file DFAMinimization.h
+ * @brief Минимизация DFA алгоритмом Хопкрофта (см. DFAMinimizer). Функции constexpr:
+ *        ими пользуется и DFAMinimizer, и построение DFA на этапе компиляции (ConstexprDFA.h).
+ */
+
+/**
+ * @brief Разбиение множества состояний на блоки с быстрым расщеплением.
+ *
+ * Элементы каждого блока лежат подряд в elems[first[b] .. end[b]); отмеченные при
+ * обработке очередного сплиттера элементы переставляются в начало блока,
+ * [first[b] .. mid[b]).
+ */
+struct StatePartition {
+    std::vector<int> elems;
+    std::vector<int> loc;
+    std::vector<int> blockOf;
+    std::vector<int> first;
+    std::vector<int> end;
+    std::vector<int> mid;
+
+    [[nodiscard]] constexpr int blockCount() const { return static_cast<int>(first.size()); }
+    [[nodiscard]] constexpr int size(int b) const { return end[b] - first[b]; }
+
+    constexpr void mark(int s) {
+      int b = blockOf[s];
+      int i = loc[s];
+      int j = mid[b];
+      if (i < j) {
+        return; // уже отмечен
+      }
+      std::swap(elems[i], elems[j]);
+      loc[elems[i]] = i;
+      loc[elems[j]] = j;
+      mid[b]++;
+    }
+
+    /**
+     * @brief Отделяет отмеченную часть блока b в новый блок.
+     * @return Номер нового блока или -1, если отмечены все элементы (расщепления нет).
+     */
+    constexpr int split(int b) {
+      if (mid[b] == end[b]) {
+        mid[b] = first[b];
+        return -1;
+      }
+      int nb = blockCount();
+      first.push_back(first[b]);
+      end.push_back(mid[b]);
+      mid.push_back(first[b]);
+      for (int i = first[b]; i < mid[b]; i++) {
+        blockOf[elems[i]] = nb;
+      }
+      first[b] = mid[b];
+      return nb;
+    }
+};
+
+/**
+ * @brief Строит минимальный DFA, распознающий те же токены, что и dfa.
+ *        Правила разбиения и нумерации — как у DFAMinimizer::minimize.
+ */
+constexpr DFA minimizeDFA(const DFA &dfa) {
+  const int n = static_cast<int>(dfa.states.size());
+  const int k = dfa.classCount;
+  const int sink = n;        // неявное мёртвое состояние
+  const int total = n + 1;
+
+  auto target = [&](int s, int c) {
+      if (s == sink) {
+        return sink;
+      }
+      int t = dfa.transitions[static_cast<size_t>(s) * k + c];
+      return t < 0 ? sink : t;
+  };
+
+  // Обратные переходы по каждому классу в формате CSR: pred[predStart[c][t] .. predStart[c][t + 1])
+  std::vector<int> predStart(static_cast<size_t>(k) * (total + 1), 0);
+  std::vector<int> pred(static_cast<size_t>(k) * total);
+  for (int c = 0; c < k; c++) {
+    int *starts = predStart.data() + static_cast<size_t>(c) * (total + 1);
+    for (int s = 0; s < total; s++) {
+      starts[target(s, c) + 1]++;
+    }
+    for (int t = 0; t < total; t++) {
+      starts[t + 1] += starts[t];
+    }
+    std::vector<int> fill(starts, starts + total);
+    int *out = pred.data() + static_cast<size_t>(c) * total;
+    for (int s = 0; s < total; s++) {
+      out[fill[target(s, c)]++] = s;
+    }
+  }
+
+  // Начальное разбиение: непринимающие (и мёртвое) + по блоку на каждый tokenIndex
+  StatePartition part;
+  part.loc.resize(total);
+  part.blockOf.resize(total);
+  // Состояния, упорядоченные по (токен, номер): блоки идут по возрастанию токена, -1 первым
+  std::vector<std::pair<int, int>> byToken;
+  byToken.reserve(total);
+  for (int s = 0; s < n; s++) {
+    byToken.emplace_back(dfa.states[s].isAccept ? dfa.states[s].tokenIndex : -1, s);
+  }
+  byToken.emplace_back(-1, sink);
+  std::sort(byToken.begin(), byToken.end());
+  for (size_t i = 0; i < byToken.size(); i++) {
+    int s = byToken[i].second;
+    if (i == 0 || byToken[i].first != byToken[i - 1].first) {
+      part.first.push_back(static_cast<int>(part.elems.size()));
+      part.end.push_back(static_cast<int>(part.elems.size()));
+      part.mid.push_back(static_cast<int>(part.elems.size()));
+    }
+    part.loc[s] = static_cast<int>(part.elems.size());
+    part.blockOf[s] = part.blockCount() - 1;
+    part.elems.push_back(s);
+    part.end.back()++;
+  }
+
+  // В очередь кладём все блоки, кроме самого большого; work[head..] ещё не обработаны
+  std::vector<int> work;
+  size_t head = 0;
+  std::vector<char> inWork(part.blockCount(), 0);
+  int largest = 0;
+  for (int b = 1; b < part.blockCount(); b++) {
+    if (part.size(b) > part.size(largest)) {
+      largest = b;
+    }
+  }
+  for (int b = 0; b < part.blockCount(); b++) {
+    if (b != largest) {
+      work.push_back(b);
+      inWork[b] = 1;
+    }
+  }
+
+  std::vector<int> splitter;
+  std::vector<int> touched;
+  while (head < work.size()) {
+    int b = work[head++];
+    inWork[b] = 0;
+    splitter.assign(part.elems.begin() + part.first[b], part.elems.begin() + part.end[b]);
+    for (int c = 0; c < k; c++) {
+      const int *starts = predStart.data() + static_cast<size_t>(c) * (total + 1);
+      const int *preds = pred.data() + static_cast<size_t>(c) * total;
+      touched.clear();
+      for (int t : splitter) {
+        for (int i = starts[t]; i < starts[t + 1]; i++) {
+          int s = preds[i];
+          int sb = part.blockOf[s];
+          if (part.mid[sb] == part.first[sb]) {
+            touched.push_back(sb);
+          }
+          part.mark(s);
+        }
+      }
+      for (int y : touched) {
+        int nb = part.split(y);
+        if (nb < 0) {
+          continue;
+        }
+        inWork.push_back(0);
+        if (inWork[y]) {
+          work.push_back(nb);
+          inWork[nb] = 1;
+        } else {
+          int smaller = part.size(nb) <= part.size(y) ? nb : y;
+          work.push_back(smaller);
+          inWork[smaller] = 1;
+        }
+      }
+    }
+  }
+
+  // Нумеруем блоки обходом в ширину от стартового; блок мёртвого состояния выбрасываем
+  DFA result;
+  result.classCount = k;
+  result.classOf = dfa.classOf;
+  result.startState = 0;
+  const int deadBlock = part.blockOf[sink];
+  const int startBlock = part.blockOf[dfa.startState];
+  if (startBlock == deadBlock) {
+    result.states.push_back({false, -1});
+    result.transitions.assign(static_cast<size_t>(k), -1);
+    return result;
+  }
+  std::vector<int> newIndex(part.blockCount(), -1);
+  std::vector<int> order;
+  newIndex[startBlock] = 0;
+  order.push_back(startBlock);
+  for (size_t i = 0; i < order.size(); i++) {
+    int rep = part.elems[part.first[order[i]]];
+    for (int c = 0; c < k; c++) {
+      int tb = part.blockOf[target(rep, c)];
+      if (tb != deadBlock && newIndex[tb] < 0) {
+        newIndex[tb] = static_cast<int>(order.size());
+        order.push_back(tb);
+      }
+    }
+  }
+  result.states.reserve(order.size());
+  result.transitions.assign(order.size() * k, -1);
+  for (size_t i = 0; i < order.size(); i++) {
+    int rep = part.elems[part.first[order[i]]];
+    result.states.push_back(dfa.states[rep]);
+    for (int c = 0; c < k; c++) {
+      int tb = part.blockOf[target(rep, c)];
+      if (tb != deadBlock) {
+        result.transitions[i * k + c] = newIndex[tb];
+      }
+    }
+  }
+  return result;
+}
@@ -0,0 +1,9 @@
+#include "DFAMinimizer.h"
+#include "DFAMinimization.h"
+
+DFA DFAMinimizer::minimize(const DFA &dfa) {
+  DFA result = minimizeDFA(dfa);
+  m_lastStats.statesBefore = dfa.states.size();
+  m_lastStats.statesAfter = result.states.size();
+  return result;
+}
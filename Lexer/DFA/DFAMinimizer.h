@@ -0,0 +1,42 @@
+#pragma once
+#include "DFA.h"
+
+#include <cstddef>
+
+/**
+ * @brief Минимизация DFA алгоритмом Хопкрофта (уточнение разбиения).
+ *
+ * Начальное разбиение: непринимающие состояния и по одному блоку на каждый tokenIndex,
+ * так что состояния, принимающие разные токены, никогда не склеиваются.
+ * Частичный DFA (переходы -1) дополняется неявным «мёртвым» состоянием; все состояния,
+ * эквивалентные ему, в результате исчезают, а переходы в них становятся -1.
+ * Классы байтов (classOf/classCount) переносятся без изменений, стартовое состояние — 0.
+ */
+class DFAMinimizer {
+public:
+    /**
+     * @brief Число состояний до и после последней минимизации.
+     */
+    struct Stats {
+        size_t statesBefore = 0;
+        size_t statesAfter = 0;
+    };
+
+    DFAMinimizer() = default;
+    ~DFAMinimizer() = default;
+
+    /**
+     * @brief Строит минимальный DFA, распознающий те же токены, что и dfa.
+     * @param dfa Исходный (например, полученный subset construction) автомат.
+     * @return Минимальный автомат.
+     */
+    DFA minimize(const DFA &dfa);
+
+    /**
+     * @brief Статистика последнего вызова minimize().
+     */
+    [[nodiscard]] const Stats &lastStats() const { return m_lastStats; }
+
+private:
+    Stats m_lastStats;
+};
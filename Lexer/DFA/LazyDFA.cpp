@@ -0,0 +1,74 @@
+#include "LazyDFA.h"
+
+LazyDFA::LazyDFA(const NFA &nfa, size_t cacheBudget)
+        : m_nfa(nfa),
+          m_cacheBudget(cacheBudget),
+          m_classCount(1),
+          m_startState(0),
+          m_stamp(0)
+{
+  m_closures = computeEpsilonClosures(m_nfa);
+  if (m_nfa.startState >= 0 && !m_nfa.states.empty()) {
+    m_classCount = computeByteClasses(m_nfa, m_classOf);
+  }
+  m_representative.resize(m_classCount);
+  for (int c = 255; c >= 0; c--) {
+    m_representative[m_classOf[c]] = static_cast<unsigned char>(c);
+  }
+  m_mark.assign(m_nfa.states.size(), 0);
+  flush();
+  m_stats.cacheFlushes = 0;
+}
+
+size_t LazyDFA::memoryUsage() const {
+  return m_sets.memoryUsage() + m_states.size() * sizeof(DfaState) + m_transitions.size() * sizeof(int);
+}
+
+void LazyDFA::flush() {
+  m_sets.clear();
+  m_states.clear();
+  m_transitions.clear();
+  m_stats.cacheFlushes++;
+  // Отдельный вектор: m_set в момент сброса может хранить ещё не добавленное множество
+  std::vector<int> start;
+  if (m_nfa.startState >= 0 && !m_nfa.states.empty()) {
+    start.assign(m_closures.begin(m_nfa.startState), m_closures.end(m_nfa.startState));
+  }
+  // Для пустого NFA это единственное состояние без переходов (как у полного построения)
+  m_startState = intern(start);
+}
+
+int LazyDFA::intern(const std::vector<int> &set) {
+  auto [id, inserted] = m_sets.findOrInsert(set);
+  if (inserted) {
+    m_states.push_back(dfaStateForSet(m_nfa, set.data(), set.size()));
+    m_transitions.resize(m_transitions.size() + m_classCount, UNKNOWN);
+    m_stats.statesBuilt++;
+  }
+  return id;
+}
+
+int LazyDFA::computeNext(int state, int cls) {
+  if (++m_stamp == 0) {
+    std::fill(m_mark.begin(), m_mark.end(), 0);
+    m_stamp = 1;
+  }
+  moveClosure(m_nfa, m_closures, m_sets.data(state), m_sets.size(state), m_representative[cls],
+              m_set, m_mark, m_stamp);
+  int target = -1;
+  if (!m_set.empty()) {
+    target = m_sets.find(m_set);
+    if (target < 0) {
+      size_t stateBytes = m_set.size() * sizeof(int) + sizeof(DfaState) + m_classCount * sizeof(int);
+      if (memoryUsage() + stateBytes > m_cacheBudget) {
+        // Сохраняем исходное множество: после сброса оно понадобится, чтобы записать переход
+        m_saved.assign(m_sets.data(state), m_sets.data(state) + m_sets.size(state));
+        flush();
+        state = intern(m_saved);
+      }
+      target = intern(m_set);
+    }
+  }
+  m_transitions[static_cast<size_t>(state) * m_classCount + cls] = target;
+  return target;
+}
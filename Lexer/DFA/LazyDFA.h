@@ -0,0 +1,108 @@
+#pragma once
+#include "DFA.h"
+#include "SubsetConstruction.h"
+#include "../NFA/NFA.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Ленивый DFA: состояния детерминизируются при первом обращении к ним (в духе RE2).
+ *
+ * При создании считаются только классы байтов и epsilon-замыкания NFA — это линейно
+ * по размеру NFA. Переход (состояние, класс) вычисляется при первом запросе next() и
+ * кэшируется; дальше next() — это одно чтение из таблицы, как у обычного DFA.
+ *
+ * Кэш ограничен бюджетом памяти: если новое состояние не помещается, кэш сбрасывается
+ * целиком, и в нём заново заводятся стартовое состояние и состояние, из которого шёл
+ * переход. Номера состояний после сброса меняются, поэтому действителен только номер,
+ * возвращённый последним вызовом next() (и startState()).
+ *
+ * Распознаёт ровно то же, что SubsetConstructionDFABuilder::buildFromNFA для того же NFA.
+ * NFA должен жить дольше автомата.
+ */
+class LazyDFA {
+public:
+    static constexpr size_t DEFAULT_CACHE_BUDGET = 8u << 20;
+
+    /**
+     * @brief Счётчики работы кэша.
+     */
+    struct Stats {
+        size_t statesBuilt = 0;    ///< Сколько раз детерминизировалось новое состояние
+        size_t cacheFlushes = 0;   ///< Сколько раз кэш сбрасывался по бюджету
+    };
+
+    /**
+     * @param nfa Объединённый NFA спецификаций токенов
+     * @param cacheBudget Предел памяти под кэш состояний, в байтах
+     */
+    explicit LazyDFA(const NFA &nfa, size_t cacheBudget = DEFAULT_CACHE_BUDGET);
+
+    /**
+     * @brief Номер стартового состояния в текущем кэше.
+     */
+    [[nodiscard]] int startState() const { return m_startState; }
+
+    /**
+     * @brief Переход из состояния state по байту c (или -1), при необходимости вычисляется.
+     *        Может сбросить кэш — тогда прежние номера состояний недействительны.
+     */
+    int next(int state, unsigned char c) {
+      int t = m_transitions[static_cast<size_t>(state) * m_classCount + m_classOf[c]];
+      return t != UNKNOWN ? t : computeNext(state, m_classOf[c]);
+    }
+
+    /**
+     * @brief Признак принятия и токен состояния из текущего кэша.
+     */
+    [[nodiscard]] const DfaState &state(int s) const { return m_states[s]; }
+
+    [[nodiscard]] int classCount() const { return m_classCount; }
+    [[nodiscard]] size_t cachedStates() const { return m_states.size(); }
+
+    /**
+     * @brief Память, занятая кэшем состояний, в байтах.
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+    [[nodiscard]] const Stats &stats() const { return m_stats; }
+
+private:
+    static constexpr int UNKNOWN = -2;  ///< Переход ещё не вычислялся
+
+    const NFA &m_nfa;
+    size_t m_cacheBudget;
+    EpsilonClosures m_closures;
+    int m_classCount;
+    std::array<uint8_t, 256> m_classOf{};
+    std::vector<unsigned char> m_representative;
+
+    StateSetTable m_sets;              ///< Множества состояний NFA закэшированных состояний
+    std::vector<DfaState> m_states;
+    std::vector<int> m_transitions;    ///< states * classCount: UNKNOWN, -1 или номер состояния
+    int m_startState;
+
+    std::vector<uint32_t> m_mark;
+    uint32_t m_stamp;
+    std::vector<int> m_set;
+    std::vector<int> m_saved;
+    Stats m_stats;
+
+    /**
+     * @brief Вычисляет и кэширует переход из state по классу cls.
+     */
+    int computeNext(int state, int cls);
+
+    /**
+     * @brief Номер состояния для множества set; новое множество добавляется в кэш.
+     */
+    int intern(const std::vector<int> &set);
+
+    /**
+     * @brief Сбрасывает кэш и заново заводит стартовое состояние.
+     */
+    void flush();
+};
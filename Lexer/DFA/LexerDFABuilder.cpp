@@ -0,0 +1,43 @@
+#include "LexerDFABuilder.h"
+#include "DFABuiler.h"
+#include "../NFA/NFABuilder.h"
+#include "../Regex/RegexParser.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+NFA LexerDFABuilder::buildNFA(const std::vector<TokenSpec> &specs) const {
+  std::vector<std::shared_ptr<RegexAST>> asts;
+  asts.reserve(specs.size());
+  std::vector<int> tokenIndices(specs.size());
+  try {
+    RegexParser parser;
+    for (size_t i = 0; i < specs.size(); i++) {
+      asts.push_back(parser.parse(specs[i].regex));
+      tokenIndices[i] = static_cast<int>(i);
+    }
+  } catch (const std::exception &e) {
+    throw std::runtime_error(std::string("Regex parse error: ") + e.what());
+  }
+
+  try {
+    ThompsonNFABuilder nfaBuilder;
+    return nfaBuilder.buildCombinedNFA(asts, tokenIndices);
+  } catch (const std::exception &e) {
+    throw std::runtime_error(std::string("Error building combined NFA: ") + e.what());
+  }
+}
+
+DFA LexerDFABuilder::build(const std::vector<TokenSpec> &specs) {
+  NFA combinedNFA = buildNFA(specs);
+  try {
+    SubsetConstructionDFABuilder dfaBuilder;
+    DFAMinimizer minimizer;
+    DFA dfa = minimizer.minimize(dfaBuilder.buildFromNFA(combinedNFA));
+    m_lastStats = minimizer.lastStats();
+    return dfa;
+  } catch (const std::exception &e) {
+    throw std::runtime_error(std::string("Error building DFA: ") + e.what());
+  }
+}
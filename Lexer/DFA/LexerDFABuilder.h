@@ -0,0 +1,41 @@
+#pragma once
+#include "DFA.h"
+#include "DFAMinimizer.h"
+#include "../NFA/NFA.h"
+#include "../TokenSpecification/TokenSpec.h"
+
+#include <vector>
+
+/**
+ * @brief DFA лексера по спецификациям токенов: RegexParser -> ThompsonNFABuilder ->
+ *        SubsetConstructionDFABuilder -> DFAMinimizer.
+ *
+ * Индекс токена в автомате — позиция спецификации в specs, поэтому specs передаются
+ * уже упорядоченными по приоритету (как их получает DfaLexer).
+ * Ошибка каждого этапа сообщается с префиксом этапа, например "Regex parse error: ...".
+ */
+class LexerDFABuilder {
+public:
+    LexerDFABuilder() = default;
+    ~LexerDFABuilder() = default;
+
+    /**
+     * @brief Объединённый NFA всех спецификаций.
+     * @throws std::runtime_error При ошибке в регулярном выражении или построении NFA.
+     */
+    NFA buildNFA(const std::vector<TokenSpec> &specs) const;
+
+    /**
+     * @brief Минимальный DFA всех спецификаций.
+     * @throws std::runtime_error При ошибке любого этапа.
+     */
+    DFA build(const std::vector<TokenSpec> &specs);
+
+    /**
+     * @brief Статистика минимизации последнего вызова build().
+     */
+    [[nodiscard]] const DFAMinimizer::Stats &lastStats() const { return m_lastStats; }
+
+private:
+    DFAMinimizer::Stats m_lastStats;
+};
@@ -0,0 +1,456 @@
+#pragma once
+#include "DFA.h"
+#include "../NFA/NFA.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file SubsetConstruction.h
+ * @brief Общие части детерминизации NFA: классы байтов, epsilon-замыкания и таблица
+ *        множеств состояний. Используются полным построением (SubsetConstructionDFABuilder),
+ *        ленивым автоматом (LazyDFA) и построением DFA на этапе компиляции (ConstexprDFA.h),
+ *        поэтому все функции — constexpr.
+ */
+
+/**
+ * @brief 64-битный хэш отсортированного множества состояний NFA.
+ */
+// noinline: см. moveClosure
+__attribute__((noinline))
+constexpr uint64_t hashStateSet(const int *data, size_t size) {
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+  for (size_t i = 0; i < size; i++) {
+    h ^= static_cast<uint64_t>(static_cast<uint32_t>(data[i])) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  }
+  // Финальное перемешивание (splitmix64), чтобы младшие биты годились для индекса в таблице
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+/**
+ * @brief Хранилище множеств состояний NFA, соответствующих состояниям DFA.
+ *
+ * Все множества (отсортированные векторы) лежат подряд в одном массиве m_pool,
+ * поиск — открытая адресация по 64-битному хэшу с линейным пробированием.
+ */
+class StateSetTable {
+public:
+    constexpr StateSetTable() : m_offsets{0}, m_slots(1024, -1) {}
+
+    /**
+     * @brief Ищет множество; если его нет, добавляет под следующим номером.
+     * @return Пара (номер множества, было ли оно добавлено).
+     */
+    constexpr std::pair<int, bool> findOrInsert(const std::vector<int> &set) {
+      uint64_t h = hashStateSet(set.data(), set.size());
+      size_t mask = m_slots.size() - 1;
+      for (size_t i = h & mask;; i = (i + 1) & mask) {
+        int id = m_slots[i];
+        if (id < 0) {
+          id = static_cast<int>(m_hashes.size());
+          m_slots[i] = id;
+          m_hashes.push_back(h);
+          m_pool.insert(m_pool.end(), set.begin(), set.end());
+          m_offsets.push_back(m_pool.size());
+          if (m_hashes.size() * 2 > m_slots.size()) {
+            grow();
+          }
+          return {id, true};
+        }
+        if (m_hashes[id] == h && size(id) == set.size() &&
+            std::equal(set.begin(), set.end(), data(id))) {
+          return {id, false};
+        }
+      }
+    }
+
+    /**
+     * @brief Номер множества или -1, если его нет в таблице.
+     */
+    [[nodiscard]] constexpr int find(const std::vector<int> &set) const {
+      uint64_t h = hashStateSet(set.data(), set.size());
+      size_t mask = m_slots.size() - 1;
+      for (size_t i = h & mask;; i = (i + 1) & mask) {
+        int id = m_slots[i];
+        if (id < 0) {
+          return -1;
+        }
+        if (m_hashes[id] == h && size(id) == set.size() &&
+            std::equal(set.begin(), set.end(), data(id))) {
+          return id;
+        }
+      }
+    }
+
+    [[nodiscard]] constexpr const int *data(int id) const { return m_pool.data() + m_offsets[id]; }
+    [[nodiscard]] constexpr size_t size(int id) const { return m_offsets[id + 1] - m_offsets[id]; }
+    [[nodiscard]] constexpr int count() const { return static_cast<int>(m_hashes.size()); }
+
+    /**
+     * @brief Удаляет все множества; номера начинаются заново с нуля.
+     */
+    constexpr void clear() {
+      m_pool.clear();
+      m_offsets.assign(1, 0);
+      m_hashes.clear();
+      m_slots.assign(1024, -1);
+    }
+
+    /**
+     * @brief Объём памяти под хранимые множества и хэш-таблицу в байтах.
+     */
+    [[nodiscard]] constexpr size_t memoryUsage() const {
+      return m_pool.size() * sizeof(int) + m_offsets.size() * sizeof(size_t)
+             + m_hashes.size() * sizeof(uint64_t) + m_slots.size() * sizeof(int);
+    }
+
+private:
+    std::vector<int> m_pool;
+    std::vector<size_t> m_offsets;
+    std::vector<uint64_t> m_hashes;
+    std::vector<int> m_slots;
+
+    constexpr void grow() {
+      std::vector<int> slots(m_slots.size() * 2, -1);
+      size_t mask = slots.size() - 1;
+      for (int id = 0; id < static_cast<int>(m_hashes.size()); id++) {
+        size_t i = m_hashes[id] & mask;
+        while (slots[i] >= 0) {
+          i = (i + 1) & mask;
+        }
+        slots[i] = id;
+      }
+      m_slots.swap(slots);
+    }
+};
+
+/**
+ * @brief Epsilon-замыкания всех состояний NFA, посчитанные один раз.
+ *
+ * Состояния одной компоненты сильной связности (по epsilon-рёбрам) имеют общее замыкание,
+ * поэтому замыкания хранятся по компонентам: замыкание состояния s — это отсортированный
+ * отрезок states[offsets[c] .. offsets[c + 1]), где c = component[s].
+ */
+struct EpsilonClosures {
+    std::vector<int> component;
+    std::vector<size_t> offsets;
+    std::vector<int> states;
+
+    [[nodiscard]] constexpr const int *begin(int s) const { return states.data() + offsets[component[s]]; }
+    [[nodiscard]] constexpr const int *end(int s) const { return states.data() + offsets[component[s] + 1]; }
+};
+
+/**
+ * @brief Считает epsilon-замыкания всех состояний: конденсация графа epsilon-переходов
+ *        в компоненты сильной связности (итеративный алгоритм Тарьяна) и объединение замыканий
+ *        компонент-потомков через общий битовый набор.
+ *        Тарьян выдаёт компоненты в обратном топологическом порядке, так что к моменту
+ *        обработки компоненты замыкания всех её потомков уже готовы.
+ */
+constexpr EpsilonClosures computeEpsilonClosures(const NFA &nfa) {
+  const int n = static_cast<int>(nfa.states.size());
+  EpsilonClosures result;
+  result.component.assign(n, -1);
+  result.offsets.push_back(0);
+
+  std::vector<int> index(n, -1);
+  std::vector<int> low(n, 0);
+  std::vector<char> onStack(n, 0);
+  std::vector<int> sccStack;
+  std::vector<std::pair<int, size_t>> callStack; // (состояние, номер следующего epsilon-ребра)
+  std::vector<uint64_t> bits((n + 63) / 64, 0);
+  std::vector<int> members;
+  std::vector<int> closure;
+  int nextIndex = 0;
+
+  for (int root = 0; root < n; root++) {
+    if (index[root] >= 0) {
+      continue;
+    }
+    callStack.emplace_back(root, 0);
+    index[root] = low[root] = nextIndex++;
+    sccStack.push_back(root);
+    onStack[root] = 1;
+    while (!callStack.empty()) {
+      auto &[v, edge] = callStack.back();
+      auto eps = nfa.epsilonOf(v);
+      if (edge < eps.size()) {
+        int w = eps[edge++];
+        if (index[w] < 0) {
+          index[w] = low[w] = nextIndex++;
+          sccStack.push_back(w);
+          onStack[w] = 1;
+          callStack.emplace_back(w, 0);
+        } else if (onStack[w]) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+      int done = v;
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        int parent = callStack.back().first;
+        low[parent] = std::min(low[parent], low[done]);
+      }
+      if (low[done] != index[done]) {
+        continue;
+      }
+      // done — корень компоненты: снимаем её со стека и собираем замыкание
+      int comp = static_cast<int>(result.offsets.size()) - 1;
+      members.clear();
+      int w;
+      do {
+        w = sccStack.back();
+        sccStack.pop_back();
+        onStack[w] = 0;
+        result.component[w] = comp;
+        members.push_back(w);
+      } while (w != done);
+
+      closure.clear();
+      auto addState = [&](int x) {
+          uint64_t bit = uint64_t{1} << (x & 63);
+          if (!(bits[x >> 6] & bit)) {
+            bits[x >> 6] |= bit;
+            closure.push_back(x);
+          }
+      };
+      for (int m : members) {
+        addState(m);
+      }
+      for (int m : members) {
+        for (int x : nfa.epsilonOf(m)) {
+          int c = result.component[x];
+          if (c == comp) {
+            continue;
+          }
+          for (size_t i = result.offsets[c]; i < result.offsets[c + 1]; i++) {
+            addState(result.states[i]);
+          }
+        }
+      }
+      std::sort(closure.begin(), closure.end());
+      for (int x : closure) {
+        bits[x >> 6] &= ~(uint64_t{1} << (x & 63));
+      }
+      result.states.insert(result.states.end(), closure.begin(), closure.end());
+      result.offsets.push_back(result.states.size());
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Записывает в `result` epsilon-замыкание множества состояний, достижимых из `states`
+ *        по символу `symbol`, как объединение заранее посчитанных замыканий (отсортировано).
+ *        Состояния результата отмечаются в mark значением stamp.
+ */
+// noinline: встроенная в цикл buildSubsetDFA, функция замедляет построение примерно на 10%
+__attribute__((noinline))
+constexpr void moveClosure(const NFA &nfa, const EpsilonClosures &closures,
+                           const int *states, size_t count, unsigned char symbol,
+                           std::vector<int> &result, std::vector<uint32_t> &mark, uint32_t stamp) {
+  result.clear();
+  for (size_t i = 0; i < count; i++) {
+    for (const NFAEdge &edge : nfa.edgesOf(states[i])) {
+      if (symbol < edge.lo || symbol > edge.hi) {
+        continue;
+      }
+      int nxt = edge.target;
+      // Если nxt уже попал в результат, его замыкание тоже там (замыкание транзитивно)
+      if (mark[nxt] == stamp) {
+        continue;
+      }
+      for (const int *x = closures.begin(nxt); x != closures.end(nxt); ++x) {
+        if (mark[*x] != stamp) {
+          mark[*x] = stamp;
+          result.push_back(*x);
+        }
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+}
+
+/**
+ * @brief Разбивает байты 0..255 на классы эквивалентности: два байта попадают в один класс,
+ *        если из каждого состояния NFA по ним есть переходы в одни и те же состояния.
+ *        Разбиение последовательно уточняется по каждому состоянию NFA.
+ * @return Количество классов; номера классов записываются в classOf.
+ */
+constexpr int computeByteClasses(const NFA &nfa, std::array<uint8_t, 256> &classOf) {
+  std::array<int, 256> cls{};
+  int count = 1;
+  std::array<int, 256> key{};
+  std::array<std::vector<int>, 256> targetsAt;
+  std::vector<const std::vector<int>*> distinct;
+  std::vector<int> remap;
+  std::vector<std::array<uint64_t, 4>> seenMasks;   // отсортирован
+  for (int s = 0; s < static_cast<int>(nfa.states.size()); s++) {
+    auto edges = nfa.edgesOf(s);
+    if (edges.empty()) {
+      continue;
+    }
+    int keyCount = 2;
+    bool singleTarget = std::all_of(edges.begin(), edges.end(),
+                                    [&](const NFAEdge &e) { return e.target == edges[0].target; });
+    if (singleTarget) {
+      // Частый случай (литерал, класс символов): байты делятся на «есть переход» и «нет».
+      // Одинаковые маски уточняют разбиение одинаково, поэтому повторы пропускаем.
+      std::array<uint64_t, 4> mask{};
+      for (const NFAEdge &edge : edges) {
+        for (int c = edge.lo; c <= edge.hi; c++) {
+          mask[c >> 6] |= uint64_t{1} << (c & 63);
+        }
+      }
+      auto seen = std::lower_bound(seenMasks.begin(), seenMasks.end(), mask);
+      if (seen != seenMasks.end() && *seen == mask) {
+        continue;
+      }
+      seenMasks.insert(seen, mask);
+      for (int c = 0; c < 256; c++) {
+        key[c] = (mask[c >> 6] >> (c & 63)) & 1 ? 1 : 0;
+      }
+    } else {
+      for (auto &targets : targetsAt) {
+        targets.clear();
+      }
+      for (const NFAEdge &edge : edges) {
+        for (int c = edge.lo; c <= edge.hi; c++) {
+          targetsAt[c].push_back(edge.target);
+        }
+      }
+      // key[c]: 0 — нет перехода, иначе номер (с 1) различного множества целей в этом состоянии
+      distinct.clear();
+      for (int c = 0; c < 256; c++) {
+        auto &targets = targetsAt[c];
+        if (targets.empty()) {
+          key[c] = 0;
+          continue;
+        }
+        std::sort(targets.begin(), targets.end());
+        int k = 0;
+        for (size_t j = 0; j < distinct.size(); j++) {
+          if (*distinct[j] == targets) {
+            k = static_cast<int>(j) + 1;
+            break;
+          }
+        }
+        if (k == 0) {
+          distinct.push_back(&targets);
+          k = static_cast<int>(distinct.size());
+        }
+        key[c] = k;
+      }
+      keyCount = static_cast<int>(distinct.size()) + 1;
+    }
+    remap.assign(static_cast<size_t>(count) * keyCount, -1);
+    int newCount = 0;
+    for (int c = 0; c < 256; c++) {
+      int &id = remap[static_cast<size_t>(cls[c]) * keyCount + key[c]];
+      if (id == -1) {
+        id = newCount++;
+      }
+      cls[c] = id;
+    }
+    count = newCount;
+  }
+  for (int c = 0; c < 256; c++) {
+    classOf[c] = static_cast<uint8_t>(cls[c]);
+  }
+  return count;
+}
+
+/**
+ * @brief Состояние DFA для множества состояний NFA: принимающее, если в множестве есть
+ *        принимающее состояние NFA; токеном становится наименьший tokenIndex.
+ */
+constexpr DfaState dfaStateForSet(const NFA &nfa, const int *set, size_t count) {
+  DfaState st;
+  st.isAccept = false;
+  st.tokenIndex = std::numeric_limits<int>::max();
+  for (size_t i = 0; i < count; i++) {
+    const NFAState &s = nfa.states[set[i]];
+    if (s.isAccept) {
+      st.isAccept = true;
+      if (s.tokenIndex < st.tokenIndex) {
+        st.tokenIndex = s.tokenIndex;
+      }
+    }
+  }
+  if (!st.isAccept) {
+    st.tokenIndex = -1;
+  }
+  return st;
+}
+
+/**
+ * @brief Создаёт новое состояние DFA для множества состояний NFA `set`
+ *        и добавляет под него строку переходов, заполненную -1.
+ */
+constexpr void addDfaStateForSet(DFA &dfa, const NFA &nfa, const std::vector<int> &set) {
+  dfa.states.push_back(dfaStateForSet(nfa, set.data(), set.size()));
+  dfa.transitions.resize(dfa.transitions.size() + dfa.classCount, -1);
+}
+
+/**
+ * @brief Полная детерминизация NFA (subset construction) по классам байтов.
+ *        Состояния DFA нумеруются в порядке обнаружения, 0 — стартовое.
+ */
+constexpr DFA buildSubsetDFA(const NFA &nfa) {
+  DFA dfa;
+  dfa.states.clear();
+  dfa.startState = 0;
+  if (nfa.startState < 0 || nfa.states.empty()) {
+    dfa.classCount = 1;
+    dfa.classOf.fill(0);
+    dfa.states.push_back({false, -1});
+    dfa.transitions.assign(1, -1);
+    return dfa;
+  }
+  dfa.classCount = computeByteClasses(nfa, dfa.classOf);
+  // Представитель каждого класса: любой его байт (переходы по всем байтам класса совпадают)
+  std::vector<unsigned char> representative(dfa.classCount);
+  for (int c = 255; c >= 0; c--) {
+    representative[dfa.classOf[c]] = static_cast<unsigned char>(c);
+  }
+
+  EpsilonClosures closures = computeEpsilonClosures(nfa);
+  // mark[s] == stamp означает «s уже в текущем собираемом множестве»; stamp растёт на каждое множество
+  std::vector<uint32_t> mark(nfa.states.size(), 0);
+  uint32_t stamp = 0;
+  std::vector<int> set(closures.begin(nfa.startState), closures.end(nfa.startState));
+
+  StateSetTable sets;
+  sets.findOrInsert(set);
+  addDfaStateForSet(dfa, nfa, set);
+  // Состояния DFA обрабатываются в порядке создания — это та же очередь «непомеченных» множеств
+  for (int currIndex = 0; currIndex < static_cast<int>(dfa.states.size()); currIndex++) {
+    for (int cls = 0; cls < dfa.classCount; cls++) {
+      if (++stamp == 0) {
+        std::fill(mark.begin(), mark.end(), 0);
+        stamp = 1;
+      }
+      moveClosure(nfa, closures, sets.data(currIndex), sets.size(currIndex), representative[cls],
+                  set, mark, stamp);
+      if (set.empty()) {
+        continue;
+      }
+      auto [targetIndex, inserted] = sets.findOrInsert(set);
+      if (inserted) {
+        addDfaStateForSet(dfa, nfa, set);
+      }
+      dfa.transitions[(size_t)currIndex * dfa.classCount + cls] = targetIndex;
+    }
+  }
+  return dfa;
+}
@@ -1,23 +1,74 @@
 #pragma once
-#include "ILexer.h"
+#include "BasicDfaLexer.h"
 #include "DFA/DFA.h"
+#include "DFA/DFAAccelerator.h"
 #include "TokenSpecification/TokenSpec.h"
 #include "Reader/IReader.h"
 #include "../SymbolTable/ISymbolTable.h"
 
+#include <memory>
 #include <vector>
-#include <string>
+
+/**
+ * @brief Адаптер таблицы DFA для BasicDfaLexer: указатели на массивы таблицы
+ *        кэшируются, чтобы шаг автомата был одним чтением без обращений к векторам.
+ */
+class DfaAutomaton {
+public:
+    static constexpr bool STABLE_STATE_IDS = true;
+
+    explicit DfaAutomaton(const DFA &dfa)
+            : m_table(dfa.transitions.data()),
+              m_classOf(dfa.classOf.data()),
+              m_classCount(static_cast<size_t>(dfa.classCount)),
+              m_states(dfa.states.data()),
+              m_stateCount(dfa.states.size()),
+              m_start(dfa.startState)
+    {}
+
+    [[nodiscard]] int start() const { return m_start; }
+
+    [[nodiscard]] int next(int state, unsigned char c) const {
+      return m_table[static_cast<size_t>(state) * m_classCount + m_classOf[c]];
+    }
+
+    [[nodiscard]] int token(int state) const {
+      return m_states[state].isAccept ? m_states[state].tokenIndex : -1;
+    }
+
+    [[nodiscard]] size_t stateCount() const { return m_stateCount; }
+
+private:
+    const int *m_table;
+    const uint8_t *m_classOf;
+    size_t m_classCount;
+    const DfaState *m_states;
+    size_t m_stateCount;
+    int m_start;
+};
+
+extern template class BasicDfaLexer<DfaAutomaton>;
 
 /**
  * @brief Лексер, работающий по готовому DFA и списку спецификаций токенов.
+ *
+ * Основной интерфейс — getNextCompactToken(): тип токена кодируется индексом спецификации,
+ * лексема отдаётся как string_view без выделения памяти. getNextToken() строит из него
+ * привычный Token со строками.
+ *
+ * Петли DFA ускоряются через DFAAccelerator: игнорируемые токены вида «байт + петля»
+ * (пробелы) пропускаются векторным сканером до обхода автомата, а серии байтов внутри
+ * ускоряемых состояний (тела комментариев) проходятся сканером вместо побайтового шага.
+ * Сам цикл разбора — BasicDfaLexer.
  */
-class DfaLexer : public ILexer {
+class DfaLexer : public BasicDfaLexer<DfaAutomaton> {
 public:
     /**
      * @param dfa Сконструированный детерминированный автомат
      * @param tokenSpecs Набор спецификаций токенов
      * @param reader Источник символов
      * @param symbolTable Указатель на таблицу символов (может быть nullptr)
+     * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
      */
     DfaLexer(const DFA &dfa,
              const std::vector<TokenSpec> &tokenSpecs,
@@ -25,13 +76,16 @@ public:
              ISymbolTable *symbolTable);
 
     /**
-     * @see ILexer::getNextToken
+     * @brief То же, но с готовым ускорителем: несколько лексеров по одному DFA (например,
+     *        по лексеру на поток) не строят его заново. Ускоритель только читается.
+     * @param accel Ускоритель, построенный по dfa и tokenSpecs; должен жить дольше лексера
      */
-    Token getNextToken() override;
+    DfaLexer(const DFA &dfa,
+             const std::vector<TokenSpec> &tokenSpecs,
+             const DFAAccelerator &accel,
+             IReader &reader,
+             ISymbolTable *symbolTable);
 
 private:
-    const DFA &m_dfa;
-    const std::vector<TokenSpec> &m_tokenSpecs;
-    IReader &m_reader;
-    ISymbolTable *m_symbolTable;
+    std::unique_ptr<DFAAccelerator> m_ownAccel;   ///< Собственный ускоритель, если общий не передан
 };
@@ -0,0 +1,297 @@
+#include "DirectCodeGenerator.h"
+
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+/**
+ * @brief Строковый литерал C++ с экранированием.
+ */
+static std::string quote(const std::string &s) {
+  std::string out = "\"";
+  for (unsigned char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += static_cast<char>(c);
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (c == '\t') {
+      out += "\\t";
+    } else if (c == '\r') {
+      out += "\\r";
+    } else if (c < 0x20 || c >= 0x7f) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\%03o", c);
+      out += buf;
+    } else {
+      out += static_cast<char>(c);
+    }
+  }
+  return out + "\"";
+}
+
+/**
+ * @brief Текст для однострочного комментария: без переводов строк.
+ */
+static std::string commentText(const std::string &s) {
+  std::string out;
+  for (char c : s) {
+    out += (c == '\n' || c == '\r') ? ' ' : c;
+  }
+  return out;
+}
+
+static bool isIdentifier(const std::string &s) {
+  if (s.empty() || std::isdigit(static_cast<unsigned char>(s[0]))) {
+    return false;
+  }
+  for (char c : s) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Тело состояния: проверка конца окна и switch по байту с goto в целевые состояния.
+ */
+static void emitState(std::ostringstream &out, const DFA &dfa, int s) {
+  out << "  S" << s << ":\n";
+  if (dfa.states[s].isAccept) {
+    out << "    accept = " << dfa.states[s].tokenIndex << ";\n"
+        << "    acceptLength = m_lexeme.size() + static_cast<size_t>(p - begin);\n";
+  }
+  // Байты группируются по целевому состоянию: один набор case-меток на цель
+  std::map<int, std::vector<int>> byTarget;
+  for (int c = 0; c < 256; c++) {
+    int t = dfa.next(s, static_cast<unsigned char>(c));
+    if (t >= 0) {
+      byTarget[t].push_back(c);
+    }
+  }
+  if (byTarget.empty()) {
+    out << "    goto done;\n";
+    return;
+  }
+  out << "    if (p == end) {\n"
+      << "      state = " << s << ";\n"
+      << "      goto refill;\n"
+      << "    }\n";
+  out << "    switch (static_cast<unsigned char>(*p)) {\n";
+  for (const auto &[target, bytes] : byTarget) {
+    for (size_t i = 0; i < bytes.size(); i++) {
+      out << (i % 8 == 0 ? "      " : " ") << "case " << bytes[i] << ":";
+      if (i % 8 == 7 || i + 1 == bytes.size()) {
+        out << "\n";
+      }
+    }
+    out << "        ++p;\n"
+        << "        goto S" << target << ";\n";
+  }
+  out << "      default:\n"
+      << "        goto done;\n"
+      << "    }\n";
+}
+
+DirectCodeGenerator::Output DirectCodeGenerator::generate(const DFA &dfa,
+                                                          const std::vector<TokenSpec> &specs,
+                                                          const std::string &className) {
+  if (specs.empty()) {
+    throw std::runtime_error("Нет спецификаций токенов для генерации лексера.");
+  }
+  if (!isIdentifier(className)) {
+    throw std::runtime_error("Некорректное имя класса лексера: " + className);
+  }
+  int identType = -1;
+  for (size_t i = 0; i < specs.size(); i++) {
+    if (specs[i].name == "IDENT") {
+      identType = static_cast<int>(i);
+      break;
+    }
+  }
+
+  Output result;
+  std::ostringstream h;
+  h << "// Сгенерировано LexerGenerator. Не редактировать вручную.\n"
+    << "#pragma once\n"
+    << "#include \"ILexer.h\"\n"
+    << "#include \"Reader/IReader.h\"\n"
+    << "#include \"ISymbolTable.h\"\n"
+    << "\n"
+    << "#include <cstddef>\n"
+    << "#include <string>\n"
+    << "\n"
+    << "/**\n"
+    << " * @brief Лексер с прямым кодированием состояний DFA (" << dfa.states.size() << " состояний).\n"
+    << " */\n"
+    << "class " << className << " : public ILexer {\n"
+    << "public:\n"
+    << "    static constexpr size_t TOKEN_COUNT = " << specs.size() << ";\n"
+    << "    static const char *const TOKEN_NAMES[TOKEN_COUNT];\n"
+    << "\n"
+    << "    /**\n"
+    << "     * @param reader Источник символов\n"
+    << "     * @param symbolTable Указатель на таблицу символов (может быть nullptr)\n"
+    << "     */\n"
+    << "    " << className << "(IReader &reader, ISymbolTable *symbolTable);\n"
+    << "\n"
+    << "    Token getNextToken() override;\n"
+    << "\n"
+    << "private:\n"
+    << "    IReader &m_reader;\n"
+    << "    ISymbolTable *m_symbolTable;\n"
+    << "    std::string m_lexeme;\n"
+    << "};\n";
+  result.header = h.str();
+
+  std::ostringstream s;
+  s << "// Сгенерировано LexerGenerator. Не редактировать вручную.\n"
+    << "#include \"" << className << ".h\"\n"
+    << "\n"
+    << "#include <span>\n"
+    << "\n"
+    << "const char *const " << className << "::TOKEN_NAMES[TOKEN_COUNT] = {\n";
+  for (const auto &spec : specs) {
+    s << "        " << quote(spec.name) << ",  // " << commentText(spec.regex) << "\n";
+  }
+  s << "};\n"
+    << "\n"
+    << "static const bool IGNORE[" << className << "::TOKEN_COUNT] = {";
+  for (size_t i = 0; i < specs.size(); i++) {
+    s << (i ? ", " : "") << (specs[i].ignore ? "true" : "false");
+  }
+  s << "};\n"
+    << "\n"
+    << "// Состояния с переходом по байту '\\0'\n"
+    << "static const bool NUL_MOVES[" << dfa.states.size() << "] = {";
+  for (size_t st = 0; st < dfa.states.size(); st++) {
+    s << (st ? ", " : "") << (dfa.next(static_cast<int>(st), 0) >= 0 ? "true" : "false");
+  }
+  s << "};\n"
+    << "\n"
+    << className << "::" << className << "(IReader &reader, ISymbolTable *symbolTable)\n"
+    << "        : m_reader(reader),\n"
+    << "          m_symbolTable(symbolTable)\n"
+    << "{\n"
+    << "}\n"
+    << "\n"
+    << "Token " << className << "::getNextToken()\n"
+    << "{\n"
+    << "  for (;;) {\n"
+    << "    if (m_reader.isEOF()) {\n"
+    << "      return {\"END_OF_FILE\", \"\", m_reader.getLine(), m_reader.getColumn()};\n"
+    << "    }\n"
+    << "    const int line = m_reader.getLine();\n"
+    << "    const int column = m_reader.getColumn();\n"
+    << "    const uint64_t offset = m_reader.getOffset();\n"
+    << "    m_reader.mark();\n"
+    << "    m_lexeme.clear();\n"
+    << "    int state = " << dfa.startState << ";\n"
+    << "    int accept = -1;\n"
+    << "    size_t acceptLength = 0;\n"
+    << "    const char *begin = nullptr;\n"
+    << "    const char *p = nullptr;\n"
+    << "    const char *end = nullptr;\n"
+    << "    char single = '\\0';\n"
+    << "    // Символы, просмотренные через peekChar, но ещё не забранные из ридера\n"
+    << "    size_t ahead = 0;\n"
+    << "\n"
+    << "  refill:\n"
+    << "    // Прочитанное из прошлого окна переносим в лексему и сдвигаем ридер\n"
+    << "    if (p != begin) {\n"
+    << "      m_lexeme.append(begin, p);\n"
+    << "      if (begin == &single) {\n"
+    << "        ahead++;\n"
+    << "      } else {\n"
+    << "        m_reader.advance(static_cast<size_t>(p - begin));\n"
+    << "      }\n"
+    << "    }\n"
+    << "    {\n"
+    << "      std::span<const char> w = ahead == 0 ? m_reader.window() : std::span<const char>();\n"
+    << "      if (!w.empty()) {\n"
+    << "        begin = w.data();\n"
+    << "        end = begin + w.size();\n"
+    << "      } else {\n"
+    << "        // Ридер без окон: окно из одного символа, просмотренного наперёд; из ридера\n"
+    << "        // забирается только допущенный префикс, и reset() ему не нужен\n"
+    << "        if (m_reader.isEOF()) {\n"
+    << "          goto finish;\n"
+    << "        }\n"
+    << "        single = m_reader.peekChar(static_cast<int>(ahead));\n"
+    << "        if (single == '\\0' && ahead > 0 && NUL_MOVES[state]) {\n"
+    << "          // За концом входа peekChar тоже отдаёт '\\0': забираем просмотренное,\n"
+    << "          // чтобы peekChar(0) отличил байт '\\0' от конца входа\n"
+    << "          for (; ahead > 0; ahead--) {\n"
+    << "            m_reader.getChar();\n"
+    << "          }\n"
+    << "          single = m_reader.peekChar(0);\n"
+    << "        }\n"
+    << "        if (ahead == 0 && m_reader.isEOF()) {\n"
+    << "          goto finish;\n"
+    << "        }\n"
+    << "        begin = &single;\n"
+    << "        end = begin + 1;\n"
+    << "      }\n"
+    << "      p = begin;\n"
+    << "    }\n"
+    << "    switch (state) {\n";
+  for (size_t st = 0; st < dfa.states.size(); st++) {
+    s << "      case " << st << ": goto S" << st << ";\n";
+  }
+  s << "      default: goto finish;\n"
+    << "    }\n"
+    << "\n";
+  for (size_t st = 0; st < dfa.states.size(); st++) {
+    emitState(s, dfa, static_cast<int>(st));
+  }
+  s << "\n"
+    << "  done:\n"
+    << "    if (p != begin) {\n"
+    << "      m_lexeme.append(begin, p);\n"
+    << "      if (begin == &single) {\n"
+    << "        ahead++;\n"
+    << "      } else {\n"
+    << "        m_reader.advance(static_cast<size_t>(p - begin));\n"
+    << "      }\n"
+    << "    }\n"
+    << "  finish:\n"
+    << "    if (accept == -1) {\n"
+    << "      // Ни один префикс не допущен: забранное из ридера возвращаем\n"
+    << "      if (m_lexeme.size() > ahead) {\n"
+    << "        m_reader.reset(offset);\n"
+    << "      }\n"
+    << "      char bad = m_reader.getChar();\n"
+    << "      if (bad == '\\0' && m_reader.isEOF()) {\n"
+    << "        return {\"END_OF_FILE\", \"\", line, column};\n"
+    << "      }\n"
+    << "      return {\"UNKNOWN\", std::string(1, bad), line, column};\n"
+    << "    }\n"
+    << "    if (m_lexeme.size() - ahead > acceptLength) {\n"
+    << "      // Откат к концу последнего допущенного префикса\n"
+    << "      m_reader.reset(offset + acceptLength);\n"
+    << "    } else {\n"
+    << "      for (size_t i = m_lexeme.size() - ahead; i < acceptLength; i++) {\n"
+    << "        m_reader.getChar();\n"
+    << "      }\n"
+    << "    }\n"
+    << "    m_lexeme.resize(acceptLength);\n"
+    << "    if (IGNORE[accept]) {\n"
+    << "      continue;\n"
+    << "    }\n";
+  if (identType >= 0) {
+    s << "    int symbolId = -1;\n"
+      << "    if (accept == " << identType << " && m_symbolTable) {\n"
+      << "      symbolId = m_symbolTable->addSymbol(m_lexeme);\n"
+      << "    }\n"
+      << "    return {TOKEN_NAMES[accept], m_lexeme, line, column, symbolId};\n";
+  } else {
+    s << "    return {TOKEN_NAMES[accept], m_lexeme, line, column};\n";
+  }
+  s << "  }\n"
+    << "}\n";
+  result.source = s.str();
+  return result;
+}
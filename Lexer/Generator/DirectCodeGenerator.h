@@ -0,0 +1,35 @@
+#pragma once
+#include "../DFA/DFA.h"
+#include "../TokenSpecification/TokenSpec.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Генератор лексера с прямым кодированием (в духе re2c): каждое состояние DFA
+ *        становится помеченным блоком кода, переходы — switch по байту и goto.
+ *
+ * Сгенерированный класс реализует ILexer и ведёт себя так же, как DfaLexer на том же DFA:
+ * автомат идёт до отсутствующего перехода, токеном становится последнее принимающее
+ * состояние, игнорируемые токены пропускаются, идентификаторы (спецификация "IDENT")
+ * заносятся в таблицу символов. Вход читается окнами IReader::window(), а для ридеров
+ * без окон — по одному символу.
+ */
+class DirectCodeGenerator {
+public:
+    /**
+     * @brief Сгенерированные исходники: заголовок <className>.h и реализация <className>.cpp.
+     */
+    struct Output {
+        std::string header;
+        std::string source;
+    };
+
+    /**
+     * @param dfa Автомат (индексы токенов — номера спецификаций в specs)
+     * @param specs Спецификации токенов
+     * @param className Имя генерируемого класса (корректный идентификатор C++)
+     * @throws std::runtime_error Если specs пуст или className не идентификатор.
+     */
+    Output generate(const DFA &dfa, const std::vector<TokenSpec> &specs, const std::string &className);
+};
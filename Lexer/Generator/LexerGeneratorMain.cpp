@@ -0,0 +1,65 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "DirectCodeGenerator.h"
+#include "../TokenSpecification/TokenSpecReader.h"
+#include "../DFA/LexerDFABuilder.h"
+
+/**
+ * @brief Записывает файл, только если его содержимое изменилось
+ *        (чтобы не пересобирать зависящие от него цели).
+ */
+static void writeIfChanged(const std::filesystem::path &path, const std::string &content)
+{
+  {
+    std::ifstream ifs(path, std::ios::binary);
+    if (ifs) {
+      std::string old((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+      if (old == content) {
+        return;
+      }
+    }
+  }
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  if (!ofs) {
+    throw std::runtime_error("Failed to create file: " + path.string());
+  }
+  ofs << content;
+  if (!ofs) {
+    throw std::runtime_error("Failed to write file: " + path.string());
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 4) {
+    std::cerr << "Usage: " << argv[0] << " <token_specs.txt> <ClassName> <output_dir>\n";
+    return 1;
+  }
+  std::string specsFile = argv[1];
+  std::string className = argv[2];
+  std::filesystem::path outDir = argv[3];
+
+  try {
+    TokenSpecReader tsReader;
+    std::vector<TokenSpec> specs = tsReader.readTokenSpecs(specsFile);
+    // Тот же порядок и тот же конвейер, что и в анализаторе
+    sortTokenSpecsByPriority(specs);
+    LexerDFABuilder dfaBuilder;
+    DFA dfa = dfaBuilder.build(specs);
+
+    DirectCodeGenerator generator;
+    DirectCodeGenerator::Output out = generator.generate(dfa, specs, className);
+    std::filesystem::create_directories(outDir);
+    writeIfChanged(outDir / (className + ".h"), out.header);
+    writeIfChanged(outDir / (className + ".cpp"), out.source);
+    std::cerr << className << ": " << dfa.states.size() << " DFA states, "
+              << specs.size() << " token specs\n";
+  } catch (const std::exception &e) {
+    std::cerr << "Lexer generation error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,158 @@
+#include "IncrementalLexer.h"
+#include "DfaLexer.h"
+#include "Reader/LineIndex.h"
+#include "Reader/StringViewReader.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Переносит позицию (line, column) со смещения from текста на смещение to >= from.
+ */
+static void advancePosition(std::string_view text, uint64_t from, uint64_t to, int &line, int &column) {
+  TextPosition pos{static_cast<uint64_t>(line), static_cast<uint64_t>(column)};
+  LineIndex::advance(pos, text.data() + from, static_cast<size_t>(to - from));
+  line = static_cast<int>(pos.line);
+  column = static_cast<int>(pos.column);
+}
+
+/**
+ * @brief Заменяет элементы [first, last) массива dst элементами src.
+ */
+template<typename T>
+static void splice(std::vector<T> &dst, size_t first, size_t last, const std::vector<T> &src) {
+  size_t common = std::min(last - first, src.size());
+  std::copy(src.begin(), src.begin() + static_cast<std::ptrdiff_t>(common), dst.begin() + static_cast<std::ptrdiff_t>(first));
+  if (common < src.size()) {
+    dst.insert(dst.begin() + static_cast<std::ptrdiff_t>(last), src.begin() + static_cast<std::ptrdiff_t>(common), src.end());
+  } else {
+    dst.erase(dst.begin() + static_cast<std::ptrdiff_t>(first + common), dst.begin() + static_cast<std::ptrdiff_t>(last));
+  }
+}
+
+IncrementalLexer::IncrementalLexer(const DFA &dfa,
+                                   const std::vector<TokenSpec> &tokenSpecs,
+                                   std::string text,
+                                   ISymbolTable *symbolTable)
+        : m_dfa(dfa),
+          m_tokenSpecs(tokenSpecs),
+          m_symbolTable(symbolTable),
+          m_accel(dfa, tokenSpecs),
+          m_text(std::move(text))
+{
+  m_tokens.source = m_text.data();
+  lexFrom(0, 1, 1, 0, m_tokens, m_reach, [](uint64_t) { return false; });
+}
+
+template<typename Stop>
+void IncrementalLexer::lexFrom(uint64_t begin, int line, int column, uint64_t reachBefore,
+                               TokenStream &out, std::vector<uint64_t> &reach, Stop &&stop)
+{
+  StringViewReader reader(m_text, static_cast<size_t>(begin));
+  DfaLexer lexer(m_dfa, m_tokenSpecs, m_accel, reader, m_symbolTable);
+  lexer.setLazyPositions(true);
+  uint64_t pos = begin;
+  for (;;) {
+    CompactToken tok = lexer.getNextCompactToken();
+    if (tok.typeId == CompactToken::END_OF_FILE_TYPE) {
+      return;
+    }
+    advancePosition(m_text, pos, tok.offset, line, column);
+    pos = tok.offset;
+    tok.line = line;
+    tok.column = column;
+    out.push(tok);
+    reach.push_back(std::max(reachBefore, lexer.scanReach()));
+    if (stop(tok.offset + tok.lexeme.size())) {
+      return;
+    }
+  }
+}
+
+IncrementalLexer::Change IncrementalLexer::edit(uint64_t offset, uint64_t removed, std::string_view inserted)
+{
+  if (offset > m_text.size() || removed > m_text.size() - offset) {
+    throw std::runtime_error("IncrementalLexer: edit range is outside of the text");
+  }
+  const size_t count = m_tokens.size();
+
+  // Первый токен, при разборе которого автомат просматривал байты от offset и дальше;
+  // токены до него от правки не зависят
+  const size_t first = static_cast<size_t>(
+          std::upper_bound(m_reach.begin(), m_reach.end(), offset) - m_reach.begin());
+  uint64_t begin = 0;
+  int line = 1;
+  int column = 1;
+  if (first > 0) {
+    begin = m_tokens.offsets[first - 1] + m_tokens.lengths[first - 1];
+    line = m_tokens.lines[first - 1];
+    column = m_tokens.columns[first - 1];
+    advancePosition(m_text, m_tokens.offsets[first - 1], begin, line, column);
+  }
+
+  m_text.replace(static_cast<size_t>(offset), static_cast<size_t>(removed), inserted);
+  m_tokens.source = m_text.data();
+  const uint64_t insertedEnd = offset + inserted.size();
+  const auto delta = static_cast<int64_t>(inserted.size()) - static_cast<int64_t>(removed);
+
+  // Перелексируем, пока граница нового токена за вставкой не совпадёт с границей старого
+  TokenStream fresh;
+  fresh.source = m_text.data();
+  std::vector<uint64_t> freshReach;
+  size_t tail = count;   // первый сохраняемый старый токен
+  size_t candidate = first;
+  lexFrom(begin, line, column, first > 0 ? m_reach[first - 1] : 0, fresh, freshReach, [&](uint64_t end) {
+      if (end < insertedEnd) {
+        return false;
+      }
+      const uint64_t oldEnd = end - inserted.size() + removed;
+      while (candidate < count && m_tokens.offsets[candidate] + m_tokens.lengths[candidate] < oldEnd) {
+        candidate++;
+      }
+      if (candidate < count && m_tokens.offsets[candidate] + m_tokens.lengths[candidate] == oldEnd) {
+        tail = candidate + 1;
+        return true;
+      }
+      return false;
+  });
+
+  Change change;
+  change.firstToken = first;
+  change.removedTokens = tail - first;
+  change.insertedTokens = fresh.size();
+  change.relexBegin = begin;
+  change.relexEnd = m_text.size();
+
+  if (tail < count) {
+    // Хвост не перелексируется: смещения сдвигаются на delta, строки — на разницу
+    // в переводах строк, столбцы — только у токенов строки, на которой сошлись потоки
+    const size_t last = fresh.size() - 1;
+    change.relexEnd = fresh.offsets[last] + fresh.lengths[last];
+    int newLine = fresh.lines[last];
+    int newColumn = fresh.columns[last];
+    const uint64_t tailOffset = static_cast<uint64_t>(static_cast<int64_t>(m_tokens.offsets[tail]) + delta);
+    advancePosition(m_text, fresh.offsets[last], tailOffset, newLine, newColumn);
+    const int syncLine = m_tokens.lines[tail];
+    const int lineDelta = newLine - syncLine;
+    const int columnDelta = newColumn - m_tokens.columns[tail];
+    uint64_t reach = freshReach.back();
+    for (size_t i = tail; i < count; i++) {
+      m_tokens.offsets[i] = static_cast<uint64_t>(static_cast<int64_t>(m_tokens.offsets[i]) + delta);
+      if (m_tokens.lines[i] == syncLine) {
+        m_tokens.columns[i] += columnDelta;
+      }
+      m_tokens.lines[i] += lineDelta;
+      reach = std::max(reach, static_cast<uint64_t>(static_cast<int64_t>(m_reach[i]) + delta));
+      m_reach[i] = reach;
+    }
+  }
+
+  splice(m_tokens.typeIds, first, tail, fresh.typeIds);
+  splice(m_tokens.offsets, first, tail, fresh.offsets);
+  splice(m_tokens.lengths, first, tail, fresh.lengths);
+  splice(m_tokens.lines, first, tail, fresh.lines);
+  splice(m_tokens.columns, first, tail, fresh.columns);
+  splice(m_tokens.symbolIds, first, tail, fresh.symbolIds);
+  splice(m_reach, first, tail, freshReach);
+  return change;
+}
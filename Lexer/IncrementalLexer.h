@@ -0,0 +1,91 @@
+#pragma once
+#include "DFA/DFA.h"
+#include "DFA/DFAAccelerator.h"
+#include "Token/TokenStream.h"
+#include "TokenSpecification/TokenSpec.h"
+#include "../SymbolTable/ISymbolTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Лексический анализ буфера редактора с перелексированием только изменённого участка.
+ *
+ * Хранит текст и его поток токенов. Правка (offset, removed, inserted) применяется к тексту,
+ * после чего заново разбирается только окрестность правки:
+ *  - начало — конец последнего токена, при разборе которого (и всего, что было до него)
+ *    автомат не заглядывал в байты от offset и дальше (DfaLexer::scanReach());
+ *  - конец — первая граница токена за вставленным текстом, которая совпадает с границей
+ *    старого потока. DfaLexer не хранит состояния между токенами, а текст за правкой
+ *    не изменился, поэтому старые токены после этой границы остаются верными
+ *    (смещаются на разницу длин).
+ *
+ * Стоимость лексического анализа пропорциональна размеру правки и задетых токенов, а не файла;
+ * хвост потока только сдвигается (смещения, строки, столбцы) одним линейным проходом.
+ * Результат совпадает с разбором всего нового текста с нуля.
+ */
+class IncrementalLexer {
+public:
+    /**
+     * @brief Изменённый участок потока после правки.
+     *
+     * Токены [firstToken, firstToken + removedTokens) старого потока заменены токенами
+     * [firstToken, firstToken + insertedTokens) нового; остальные сохранены.
+     */
+    struct Change {
+        size_t firstToken = 0;
+        size_t removedTokens = 0;
+        size_t insertedTokens = 0;
+        uint64_t relexBegin = 0;   ///< Начало заново разобранного участка нового текста
+        uint64_t relexEnd = 0;     ///< Его конец (граница, на которой потоки сошлись)
+    };
+
+    /**
+     * @param dfa Автомат лексера
+     * @param tokenSpecs Набор спецификаций токенов
+     * @param text Начальный текст (разбирается целиком)
+     * @param symbolTable Таблица символов для токенов IDENT (может быть nullptr);
+     *        идентификаторы удалённых токенов из неё не удаляются
+     * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
+     */
+    IncrementalLexer(const DFA &dfa,
+                     const std::vector<TokenSpec> &tokenSpecs,
+                     std::string text,
+                     ISymbolTable *symbolTable = nullptr);
+
+    /**
+     * @brief Заменяет removed байт текста, начиная с offset, на inserted и обновляет поток.
+     * @throws std::runtime_error Если [offset, offset + removed) выходит за текст.
+     */
+    Change edit(uint64_t offset, uint64_t removed, std::string_view inserted);
+
+    [[nodiscard]] const std::string &text() const { return m_text; }
+
+    /**
+     * @brief Текущий поток токенов; лексемы ссылаются на text() (до следующей правки).
+     */
+    [[nodiscard]] const TokenStream &tokens() const { return m_tokens; }
+
+private:
+    const DFA &m_dfa;
+    const std::vector<TokenSpec> &m_tokenSpecs;
+    ISymbolTable *m_symbolTable;
+    DFAAccelerator m_accel;
+    std::string m_text;
+    TokenStream m_tokens;
+    /// m_reach[i] — scanReach() после получения токена i: докуда автомат просмотрел
+    /// текст, разбирая токены 0..i (неубывающий массив)
+    std::vector<uint64_t> m_reach;
+
+    /**
+     * @brief Разбирает m_text с позиции begin (граница токенов) в out/reach, пока stop()
+     *        не вернёт true для границы очередного токена или не кончится вход.
+     *        Строки и столбцы считаются от позиции (line, column) смещения begin.
+     */
+    template<typename Stop>
+    void lexFrom(uint64_t begin, int line, int column, uint64_t reachBefore,
+                 TokenStream &out, std::vector<uint64_t> &reach, Stop &&stop);
+};
@@ -0,0 +1,11 @@
+#include "LazyDfaLexer.h"
+
+template class BasicDfaLexer<LazyDfaAutomaton>;
+
+LazyDfaLexer::LazyDfaLexer(LazyDFA &dfa,
+                           const std::vector<TokenSpec> &tokenSpecs,
+                           IReader &reader,
+                           ISymbolTable *symbolTable)
+        : BasicDfaLexer(LazyDfaAutomaton(dfa), tokenSpecs, nullptr, reader, symbolTable)
+{
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "BasicDfaLexer.h"
+#include "DFA/LazyDFA.h"
+#include "TokenSpecification/TokenSpec.h"
+#include "Reader/IReader.h"
+#include "../SymbolTable/ISymbolTable.h"
+
+#include <vector>
+
+/**
+ * @brief Адаптер LazyDFA для BasicDfaLexer. Номера состояний меняются при сбросе кэша,
+ *        поэтому мемоизация линейного времени для него недоступна.
+ */
+class LazyDfaAutomaton {
+public:
+    static constexpr bool STABLE_STATE_IDS = false;
+
+    explicit LazyDfaAutomaton(LazyDFA &dfa) : m_dfa(&dfa) {}
+
+    [[nodiscard]] int start() const { return m_dfa->startState(); }
+
+    [[nodiscard]] int next(int state, unsigned char c) const { return m_dfa->next(state, c); }
+
+    [[nodiscard]] int token(int state) const {
+      const DfaState &st = m_dfa->state(state);
+      return st.isAccept ? st.tokenIndex : -1;
+    }
+
+    [[nodiscard]] size_t stateCount() const { return m_dfa->cachedStates(); }
+
+private:
+    LazyDFA *m_dfa;
+};
+
+extern template class BasicDfaLexer<LazyDfaAutomaton>;
+
+/**
+ * @brief Лексер поверх ленивого DFA (LazyDFA): состояния автомата строятся по мере того,
+ *        как до них доходит вход, поэтому запуск не требует полного построения DFA.
+ *
+ * Токены и их границы совпадают с DfaLexer на DFA, построенном из того же NFA.
+ * Цикл разбора — BasicDfaLexer (без ускорителя петель).
+ */
+class LazyDfaLexer : public BasicDfaLexer<LazyDfaAutomaton> {
+public:
+    /**
+     * @param dfa Ленивый автомат (общий кэш, лексер его достраивает)
+     * @param tokenSpecs Набор спецификаций токенов
+     * @param reader Источник символов
+     * @param symbolTable Указатель на таблицу символов (может быть nullptr)
+     * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
+     */
+    LazyDfaLexer(LazyDFA &dfa,
+                 const std::vector<TokenSpec> &tokenSpecs,
+                 IReader &reader,
+                 ISymbolTable *symbolTable);
+};
@@ -1,22 +1,54 @@
 #pragma once
+#include <cstdint>
+#include <span>
 #include <vector>
 
+/**
+ * @brief Переход NFA по диапазону байтов [lo, hi] в состояние target.
+ */
+struct NFAEdge {
+    unsigned char lo;
+    unsigned char hi;
+    int target;
+};
+
 /**
  * @brief Структура состояния недетерминированного конечного автомата (NFA).
+ *        Переходы состояния хранятся в общих массивах NFA (см. NFA::edgesOf, NFA::epsilonOf).
  */
 struct NFAState {
     bool isAccept = false;
     int tokenIndex = -1;
-    std::vector<int> transitions[256];
-    std::vector<int> epsilon;
 };
 
 /**
  * @brief Структура NFA: набор состояний, индекс стартового состояния и индекс
  *        единственного принимающего состояния (или -1, если их несколько).
+ *
+ * Переходы лежат в компактном виде (CSR): рёбра состояния s по байтам —
+ * edges[edgeOffsets[s] .. edgeOffsets[s + 1]), epsilon-переходы —
+ * epsilonTargets[epsilonOffsets[s] .. epsilonOffsets[s + 1]).
  */
 struct NFA {
     std::vector<NFAState> states;
     int startState = -1;
     int acceptState = -1;
+    std::vector<uint32_t> edgeOffsets;
+    std::vector<NFAEdge> edges;
+    std::vector<uint32_t> epsilonOffsets;
+    std::vector<int> epsilonTargets;
+
+    /**
+     * @brief Переходы состояния s по диапазонам байтов.
+     */
+    [[nodiscard]] constexpr std::span<const NFAEdge> edgesOf(int s) const {
+      return {edges.data() + edgeOffsets[s], edges.data() + edgeOffsets[s + 1]};
+    }
+
+    /**
+     * @brief Epsilon-переходы состояния s.
+     */
+    [[nodiscard]] constexpr std::span<const int> epsilonOf(int s) const {
+      return {epsilonTargets.data() + epsilonOffsets[s], epsilonTargets.data() + epsilonOffsets[s + 1]};
+    }
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "INFABuilder.h"
+#include "ThompsonArena.h"
 
 /**
  * @brief Класс-строитель NFA по алгоритму Томпсона.
@@ -7,6 +8,9 @@
  * Предоставляет функции для:
  *  - Построения NFA из одного регулярного выражения (AST).
  *  - Объединения нескольких NFA (для разных выражений) в один.
+ *
+ * Все фрагменты одного построения живут в общей арене состояний (ThompsonArena),
+ * общей с построением NFA на этапе компиляции.
  */
 class ThompsonNFABuilder : public INFABuilder {
 public:
@@ -32,49 +36,11 @@ public:
 NFA buildBasicNFA(char c);
 
 private:
-    /**
-     * @brief Рекурсивное построение NFA из AST (одна регулярка).
-     * @param ast Корень AST.
-     */
-    NFA buildFromASTImpl(const std::shared_ptr<RegexAST> &ast);
-
-    /**
-     * @brief Создаёт NFA, соответствующий объединению A|B (альтернатива).
-     */
-    NFA alternateNFA(const NFA &a, const NFA &b);
-
-    /**
-     * @brief Создаёт NFA для конкатенации A B.
-     */
-    NFA concatNFA(const NFA &a, const NFA &b);
-
-    /**
-     * @brief Создаёт NFA для звезды Клини (A*).
-     */
-    NFA starNFA(const NFA &a);
+    ThompsonArena m_arena; ///< Арена состояний текущего построения
 
     /**
-     * @brief Создаёт NFA для A+ (один или более повторений).
-     */
-    NFA plusNFA(const NFA &a);
-
-    /**
-     * @brief Создаёт NFA для A? (ноль или одно вхождение).
-     */
-    NFA questionNFA(const NFA &a);
-
-    /**
-     * @brief Добавляет новое состояние в NFA, возвращает его индекс.
-     */
-    int addState(NFA &nfa);
-
-    /**
-     * @brief Копирует вектор состояний в другой NFA со смещением индексов.
-     */
-    std::vector<NFAState> copyStatesWithOffset(const std::vector<NFAState> &states, int offset);
-
-    /**
-     * @brief Разворачивает диапазоны в классе символов (например, "a-z" -> "abc...xyz").
+     * @brief Рекурсивное построение фрагмента из AST (одна регулярка).
+     * @param ast Корень AST.
      */
-    std::string expandCharClass(const std::string &charClassExpr);
+    ThompsonArena::Fragment buildFromASTImpl(const std::shared_ptr<RegexAST> &ast);
 };
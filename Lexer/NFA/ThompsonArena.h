@@ -0,0 +1,232 @@
+#pragma once
+#include "NFA.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Арена построения NFA по Томпсону: все фрагменты одного построения живут в общем
+ *        массиве состояний; фрагмент — пара (start, accept), и каждый комбинатор добавляет
+ *        O(1) состояний и рёбер, ничего не копируя.
+ *
+ * Используется ThompsonNFABuilder (по AST) и как построитель для RegexGrammar — тогда
+ * фрагменты строятся прямо при разборе, без AST, в том числе на этапе компиляции.
+ */
+class ThompsonArena {
+public:
+    /**
+     * @brief Фрагмент NFA в арене: стартовое и единственное принимающее состояние.
+     */
+    struct Fragment {
+        int start;
+        int accept;
+    };
+
+    using Node = Fragment;
+
+    /**
+     * @brief Добавляет новое состояние (пустое), возвращает его индекс.
+     */
+    constexpr int addState() {
+      m_states.emplace_back();
+      return static_cast<int>(m_states.size()) - 1;
+    }
+
+    /**
+     * @brief Делает state принимающим с токеном tokenIndex.
+     */
+    constexpr void setAccept(int state, int tokenIndex = -1) {
+      m_states[state].isAccept = true;
+      m_states[state].tokenIndex = tokenIndex;
+    }
+
+    constexpr void addEpsilon(int from, int to) {
+      m_states[from].epsilon.push_back(to);
+    }
+
+    /**
+     * @brief Фрагмент из одного символа c (или ε, если c == '\0'): start -> accept.
+     */
+    constexpr Fragment literal(char c) {
+      int s0 = addState();
+      int s1 = addState();
+      if (c == '\0') {
+        m_states[s0].epsilon.push_back(s1);
+      } else {
+        auto uc = static_cast<unsigned char>(c);
+        m_states[s0].edges.push_back({uc, uc, s1});
+      }
+      return {s0, s1};
+    }
+
+    constexpr Fragment epsilon() {
+      return literal('\0');
+    }
+
+    /**
+     * @brief Фрагмент для класса символов (например, "a-z_").
+     * @throws std::runtime_error Если класс пуст или диапазон задан в обратном порядке.
+     */
+    constexpr Fragment charClass(std::string_view expr) {
+      if (expr.empty()) {
+        throw std::runtime_error("Пустой класс символов (CharClass) в регулярном выражении.");
+      }
+      return charClassFragment(charClassMask(expr));
+    }
+
+    /**
+     * @brief Фрагмент для класса символов: start -> accept рёбрами по непрерывным
+     *        отрезкам маски (например, [a-zA-Z0-9_] — это 4 ребра вместо 63 альтернатив).
+     */
+    constexpr Fragment charClassFragment(const std::array<bool, 256> &mask) {
+      int s0 = addState();
+      int s1 = addState();
+      int c = 0;
+      while (c < 256) {
+        if (!mask[c]) {
+          c++;
+          continue;
+        }
+        int lo = c;
+        while (c < 256 && mask[c]) {
+          c++;
+        }
+        m_states[s0].edges.push_back({static_cast<unsigned char>(lo), static_cast<unsigned char>(c - 1), s1});
+      }
+      return {s0, s1};
+    }
+
+    /**
+     * @brief Альтернатива A|B: новые start и accept, четыре epsilon-ребра.
+     */
+    constexpr Fragment alternate(Fragment a, Fragment b) {
+      int newStart = addState();
+      int newAccept = addState();
+      m_states[newStart].epsilon.push_back(a.start);
+      m_states[newStart].epsilon.push_back(b.start);
+      m_states[a.accept].epsilon.push_back(newAccept);
+      m_states[b.accept].epsilon.push_back(newAccept);
+      return {newStart, newAccept};
+    }
+
+    /**
+     * @brief Конкатенация A B: epsilon-ребро accept(A) -> start(B).
+     */
+    constexpr Fragment concat(Fragment a, Fragment b) {
+      m_states[a.accept].epsilon.push_back(b.start);
+      return {a.start, b.accept};
+    }
+
+    /**
+     * @brief Звезда Клини A*: новое start, newAccept.
+     *  - epsilon(newStart -> A.start, newStart -> newAccept)
+     *  - epsilon(A.accept -> A.start, A.accept -> newAccept)
+     */
+    constexpr Fragment star(Fragment a) {
+      int newStart = addState();
+      int newAccept = addState();
+      m_states[newStart].epsilon.push_back(a.start);
+      m_states[newStart].epsilon.push_back(newAccept);
+      m_states[a.accept].epsilon.push_back(a.start);
+      m_states[a.accept].epsilon.push_back(newAccept);
+      return {newStart, newAccept};
+    }
+
+    /**
+     * @brief A+: как A*, но без обхода A — epsilon(A.accept -> A.start, A.accept -> newAccept).
+     *        Сам фрагмент A не дублируется.
+     */
+    constexpr Fragment plus(Fragment a) {
+      int newAccept = addState();
+      m_states[a.accept].epsilon.push_back(a.start);
+      m_states[a.accept].epsilon.push_back(newAccept);
+      return {a.start, newAccept};
+    }
+
+    /**
+     * @brief A? = (ε | A): epsilon(newStart -> A.start, newStart -> newAccept, A.accept -> newAccept)
+     */
+    constexpr Fragment question(Fragment a) {
+      int newStart = addState();
+      int newAccept = addState();
+      m_states[newStart].epsilon.push_back(a.start);
+      m_states[newStart].epsilon.push_back(newAccept);
+      m_states[a.accept].epsilon.push_back(newAccept);
+      return {newStart, newAccept};
+    }
+
+    /**
+     * @brief Упаковывает арену в компактный NFA: переходы всех состояний
+     *        выкладываются подряд в общие массивы. Арена после этого пуста.
+     */
+    constexpr NFA pack(int startState, int acceptState) {
+      NFA nfa;
+      nfa.startState = startState;
+      nfa.acceptState = acceptState;
+      nfa.states.reserve(m_states.size());
+      nfa.edgeOffsets.reserve(m_states.size() + 1);
+      nfa.epsilonOffsets.reserve(m_states.size() + 1);
+      nfa.edgeOffsets.push_back(0);
+      nfa.epsilonOffsets.push_back(0);
+      for (const auto &st : m_states) {
+        nfa.states.push_back({st.isAccept, st.tokenIndex});
+        nfa.edges.insert(nfa.edges.end(), st.edges.begin(), st.edges.end());
+        nfa.epsilonTargets.insert(nfa.epsilonTargets.end(), st.epsilon.begin(), st.epsilon.end());
+        nfa.edgeOffsets.push_back(static_cast<uint32_t>(nfa.edges.size()));
+        nfa.epsilonOffsets.push_back(static_cast<uint32_t>(nfa.epsilonTargets.size()));
+      }
+      m_states.clear();
+      return nfa;
+    }
+
+    /**
+     * @brief Удаляет все состояния.
+     */
+    constexpr void clear() { m_states.clear(); }
+
+    /**
+     * @brief Переводит класс символов (например, "a-z_") в маску байтов:
+     *        диапазоны вида "a-z" и отдельные символы.
+     * @throws std::runtime_error Если диапазон задан в обратном порядке.
+     */
+    static constexpr std::array<bool, 256> charClassMask(std::string_view expr) {
+      std::array<bool, 256> mask{};
+      size_t i = 0;
+      while (i < expr.size()) {
+        // Если впереди как минимум три символа и средний — '-'
+        if (i + 2 < expr.size() && expr[i + 1] == '-') {
+          char start = expr[i];
+          char end = expr[i + 2];
+          if (start > end) {
+            throw std::runtime_error("Bad range in char class: " + std::string(expr));
+          }
+          for (int c = static_cast<unsigned char>(start); c <= static_cast<unsigned char>(end); ++c) {
+            mask[c] = true;
+          }
+          i += 3;
+        } else {
+          mask[static_cast<unsigned char>(expr[i])] = true;
+          ++i;
+        }
+      }
+      return mask;
+    }
+
+private:
+    /**
+     * @brief Состояние арены: переходы хранятся прямо в состоянии,
+     *        чтобы комбинаторы могли дописывать рёбра в уже созданные состояния.
+     */
+    struct DraftState {
+        bool isAccept = false;
+        int tokenIndex = -1;
+        std::vector<NFAEdge> edges;
+        std::vector<int> epsilon;
+    };
+
+    std::vector<DraftState> m_states;
+};
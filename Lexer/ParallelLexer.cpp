@@ -0,0 +1,261 @@
+#include "ParallelLexer.h"
+#include "DfaLexer.h"
+#include "Reader/LineIndex.h"
+#include "Reader/StringViewReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+/// Насколько далеко от номинальной границы куска ищется перевод строки.
+static constexpr size_t MAX_BOUNDARY_SHIFT = 4096;
+
+/**
+ * @brief Токен без лексемы: тип, начало и длина.
+ */
+struct TokenRef {
+    uint16_t typeId = CompactToken::END_OF_FILE_TYPE;
+    uint64_t offset = 0;
+    uint32_t length = 0;
+};
+
+static TokenRef toRef(const CompactToken &token) {
+  return {token.typeId, token.offset, TokenStream::lengthOf(token.lexeme)};
+}
+
+/**
+ * @brief Результат спекулятивного лексирования куска [begin, end).
+ */
+struct SpeculativeChunk {
+    std::vector<uint16_t> typeIds;
+    std::vector<uint64_t> offsets;   ///< Возрастают; все токены начинаются в [begin, end)
+    std::vector<uint32_t> lengths;
+    TokenRef next;                   ///< Первый токен с началом >= end (или END_OF_FILE)
+};
+
+/**
+ * @brief Выполняет job(0), ..., job(n - 1) в n потоках (job(0) — в вызывающем)
+ *        и пробрасывает первое исключение.
+ */
+static void runParallel(size_t n, const std::function<void(size_t)> &job) {
+  std::vector<std::exception_ptr> errors(n);
+  std::vector<std::thread> threads;
+  threads.reserve(n > 0 ? n - 1 : 0);
+  for (size_t i = 1; i < n; i++) {
+    threads.emplace_back([&, i] {
+        try {
+          job(i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+    });
+  }
+  if (n > 0) {
+    try {
+      job(0);
+    } catch (...) {
+      errors[0] = std::current_exception();
+    }
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (const auto &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+static void lexChunk(const DFA &dfa, const std::vector<TokenSpec> &specs, const DFAAccelerator &accel,
+                     std::string_view input, size_t begin, size_t end, SpeculativeChunk &chunk) {
+  StringViewReader reader(input, begin);
+  DfaLexer lexer(dfa, specs, accel, reader, nullptr);
+  lexer.setLazyPositions(true);
+  for (;;) {
+    CompactToken tok = lexer.getNextCompactToken();
+    if (tok.typeId == CompactToken::END_OF_FILE_TYPE || tok.offset >= end) {
+      chunk.next = toRef(tok);
+      return;
+    }
+    chunk.typeIds.push_back(tok.typeId);
+    chunk.offsets.push_back(tok.offset);
+    chunk.lengths.push_back(TokenStream::lengthOf(tok.lexeme));
+  }
+}
+
+/**
+ * @brief Дописывает в out токены куска, начиная с from.
+ */
+static void appendFrom(const SpeculativeChunk &chunk, size_t from, TokenStream &out) {
+  out.typeIds.insert(out.typeIds.end(), chunk.typeIds.begin() + from, chunk.typeIds.end());
+  out.offsets.insert(out.offsets.end(), chunk.offsets.begin() + from, chunk.offsets.end());
+  out.lengths.insert(out.lengths.end(), chunk.lengths.begin() + from, chunk.lengths.end());
+}
+
+static void appendRef(const TokenRef &token, TokenStream &out) {
+  out.typeIds.push_back(token.typeId);
+  out.offsets.push_back(token.offset);
+  out.lengths.push_back(token.length);
+}
+
+ParallelLexer::ParallelLexer(const DFA &dfa,
+                             const std::vector<TokenSpec> &tokenSpecs,
+                             unsigned threads,
+                             size_t minChunkSize)
+        : m_dfa(dfa),
+          m_tokenSpecs(tokenSpecs),
+          m_threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          m_minChunkSize(std::max<size_t>(1, minChunkSize)),
+          m_identTypeId(-1),
+          m_accel(dfa, tokenSpecs)
+{
+  if (m_tokenSpecs.size() > CompactToken::MAX_SPEC_COUNT) {
+    throw std::runtime_error("Слишком много спецификаций токенов: " + std::to_string(m_tokenSpecs.size()));
+  }
+  for (size_t i = 0; i < m_tokenSpecs.size(); i++) {
+    if (m_tokenSpecs[i].name == "IDENT") {
+      m_identTypeId = static_cast<int>(i);
+      break;
+    }
+  }
+}
+
+std::vector<size_t> ParallelLexer::splitPoints(std::string_view input) const
+{
+  size_t chunks = std::min<size_t>(m_threads, std::max<size_t>(1, input.size() / m_minChunkSize));
+  std::vector<size_t> bounds = {0};
+  for (size_t i = 1; i < chunks; i++) {
+    size_t p = input.size() / chunks * i;
+    size_t limit = std::min(input.size(), p + MAX_BOUNDARY_SHIFT);
+    const void *nl = std::memchr(input.data() + p, '\n', limit - p);
+    if (nl) {
+      p = static_cast<size_t>(static_cast<const char*>(nl) - input.data()) + 1;
+    }
+    if (p > bounds.back() && p < input.size()) {
+      bounds.push_back(p);
+    }
+  }
+  bounds.push_back(input.size());
+  return bounds;
+}
+
+size_t ParallelLexer::tokenize(std::string_view input, TokenStream &out, ISymbolTable *symbolTable)
+{
+  if (!out.empty() || !out.text.empty()) {
+    throw std::runtime_error("ParallelLexer::tokenize: output stream must be empty");
+  }
+  m_stats = Stats{};
+  std::vector<size_t> bounds = splitPoints(input);
+  const size_t chunkCount = bounds.size() - 1;
+  m_stats.chunks = chunkCount;
+
+  std::vector<SpeculativeChunk> chunks(chunkCount);
+  runParallel(chunkCount, [&](size_t k) {
+      lexChunk(m_dfa, m_tokenSpecs, m_accel, input, bounds[k], bounds[k + 1], chunks[k]);
+  });
+
+  // Сшивка. Кусок 0 начинается с начала входа, его поток истинный; next — истинный
+  // токен, следующий за последним уже записанным
+  out.source = input.data();
+  size_t total = 0;
+  for (const auto &chunk : chunks) {
+    total += chunk.typeIds.size();
+  }
+  out.reserve(total);
+  appendFrom(chunks[0], 0, out);
+  m_stats.syncedChunks = 1;
+  TokenRef next = chunks[0].next;
+  for (size_t k = 1; k < chunkCount && next.typeId != CompactToken::END_OF_FILE_TYPE; k++) {
+    const SpeculativeChunk &chunk = chunks[k];
+    if (next.offset >= bounds[k + 1]) {
+      // Токен перекрывает кусок целиком — в куске нет истинных начал токенов
+      continue;
+    }
+    auto hit = std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), next.offset);
+    if (hit != chunk.offsets.end() && *hit == next.offset) {
+      appendFrom(chunk, static_cast<size_t>(hit - chunk.offsets.begin()), out);
+      next = chunk.next;
+      m_stats.syncedChunks++;
+      continue;
+    }
+    // Граница пришлась внутрь токена: лексируем с истинной позиции, пока начало
+    // очередного токена не совпадёт с началом токена из спекулятивного потока
+    StringViewReader reader(input, next.offset);
+    DfaLexer lexer(m_dfa, m_tokenSpecs, m_accel, reader, nullptr);
+    lexer.setLazyPositions(true);
+    for (;;) {
+      TokenRef tok = toRef(lexer.getNextCompactToken());
+      m_stats.relexedTokens++;
+      if (tok.typeId == CompactToken::END_OF_FILE_TYPE || tok.offset >= bounds[k + 1]) {
+        next = tok;
+        break;
+      }
+      hit = std::lower_bound(hit, chunk.offsets.end(), tok.offset);
+      if (hit != chunk.offsets.end() && *hit == tok.offset) {
+        appendFrom(chunk, static_cast<size_t>(hit - chunk.offsets.begin()), out);
+        next = chunk.next;
+        break;
+      }
+      appendRef(tok, out);
+    }
+  }
+
+  const size_t count = out.typeIds.size();
+  out.lines.resize(count);
+  out.columns.resize(count);
+  out.symbolIds.assign(count, -1);
+  if (symbolTable && m_identTypeId >= 0) {
+    // Номера символов раздаются в порядке токенов, как при последовательном проходе
+    for (size_t i = 0; i < count; i++) {
+      if (out.typeIds[i] == m_identTypeId) {
+        out.symbolIds[i] = symbolTable->addSymbol(std::string(out.lexeme(i)));
+      }
+    }
+  }
+  fillLineColumns(input, out, chunkCount);
+  return count;
+}
+
+void ParallelLexer::fillLineColumns(std::string_view input, TokenStream &out, size_t parts) const
+{
+  const size_t count = out.size();
+  if (count == 0) {
+    return;
+  }
+  parts = std::min(parts, count);
+  std::vector<size_t> first(parts + 1);
+  for (size_t r = 0; r <= parts; r++) {
+    first[r] = count / parts * r + std::min(r, count % parts);
+  }
+  // Сколько переводов строки лежит перед первым токеном каждого диапазона
+  std::vector<int> newlines(parts + 1, 0);
+  runParallel(parts, [&](size_t r) {
+      if (r + 1 == parts) {
+        return;
+      }
+      uint64_t from = r == 0 ? 0 : out.offsets[first[r]];
+      uint64_t to = out.offsets[first[r + 1]];
+      newlines[r + 1] = static_cast<int>(std::count(input.data() + from, input.data() + to, '\n'));
+  });
+  for (size_t r = 1; r <= parts; r++) {
+    newlines[r] += newlines[r - 1];
+  }
+  runParallel(parts, [&](size_t r) {
+      uint64_t pos = r == 0 ? 0 : out.offsets[first[r]];
+      size_t lastNewline = pos == 0 ? std::string_view::npos : input.rfind('\n', pos - 1);
+      uint64_t lineStart = lastNewline == std::string_view::npos ? 0 : lastNewline + 1;
+      TextPosition at{static_cast<uint64_t>(1 + newlines[r]), pos - lineStart + 1};
+      for (size_t i = first[r]; i < first[r + 1]; i++) {
+        uint64_t offset = out.offsets[i];
+        LineIndex::advance(at, input.data() + pos, static_cast<size_t>(offset - pos));
+        pos = offset;
+        out.lines[i] = static_cast<int>(at.line);
+        out.columns[i] = static_cast<int>(at.column);
+      }
+  });
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "DFA/DFA.h"
+#include "DFA/DFAAccelerator.h"
+#include "Token/TokenStream.h"
+#include "TokenSpecification/TokenSpec.h"
+#include "../SymbolTable/ISymbolTable.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Параллельная разбивка на токены одного большого буфера поверх DfaLexer.
+ *
+ * Буфер делится на N кусков; граница куска сдвигается за ближайший перевод строки
+ * (эвристика: строка обычно начинается с начала токена). Каждый кусок в своём потоке
+ * лексируется «наугад» из стартового состояния DFA, как если бы с его начала начинался вход.
+ *
+ * Затем куски сшиваются по порядку. DfaLexer не хранит состояния между токенами, поэтому
+ * токен однозначно определяется своим началом: если истинный поток токенов (известный
+ * до конца предыдущего куска) и спекулятивный поток куска содержат токен с одним и тем же
+ * смещением, дальше они совпадают. Найти такую точку удаётся сразу, если граница попала
+ * между токенами; иначе (граница внутри комментария или строки) кусок перелексируется
+ * последовательно с истинной позиции, пока потоки не сойдутся.
+ *
+ * Номера символов таблицы символов раздаются после сшивки в порядке токенов, строки
+ * и столбцы вычисляются по смещениям, так что результат совпадает с последовательным
+ * DfaLexer::tokenizeAll() до байта.
+ */
+class ParallelLexer {
+public:
+    static constexpr size_t DEFAULT_MIN_CHUNK_SIZE = 1 << 20;
+
+    /**
+     * @brief Статистика последнего вызова tokenize().
+     */
+    struct Stats {
+        size_t chunks = 0;          ///< На сколько кусков разбит вход
+        size_t syncedChunks = 0;    ///< Куски, спекулятивный поток которых подошёл без перелексирования
+        size_t relexedTokens = 0;   ///< Токены, перелексированные при сшивке
+    };
+
+    /**
+     * @param dfa Автомат (только читается, общий для всех потоков)
+     * @param tokenSpecs Набор спецификаций токенов
+     * @param threads Число потоков; 0 — std::thread::hardware_concurrency()
+     * @param minChunkSize Минимальный размер куска: маленький вход делится на меньшее число частей
+     * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
+     */
+    ParallelLexer(const DFA &dfa,
+                  const std::vector<TokenSpec> &tokenSpecs,
+                  unsigned threads = 0,
+                  size_t minChunkSize = DEFAULT_MIN_CHUNK_SIZE);
+
+    /**
+     * @brief Разбивает input на токены и дописывает их в out (END_OF_FILE не пишется).
+     *
+     * Лексемы ссылаются на input (out.source), поэтому input должен жить не меньше out.
+     * @param out Пустой поток
+     * @param symbolTable Таблица символов для токенов IDENT (может быть nullptr)
+     * @return Сколько токенов добавлено.
+     * @throws std::runtime_error Если out не пуст.
+     */
+    size_t tokenize(std::string_view input, TokenStream &out, ISymbolTable *symbolTable);
+
+    [[nodiscard]] const Stats &lastStats() const { return m_stats; }
+
+private:
+    const DFA &m_dfa;
+    const std::vector<TokenSpec> &m_tokenSpecs;
+    unsigned m_threads;
+    size_t m_minChunkSize;
+    int m_identTypeId;    ///< typeId спецификации IDENT (или -1)
+    DFAAccelerator m_accel;   ///< Строится один раз, общий для лексеров всех кусков
+    Stats m_stats;
+
+    /**
+     * @brief Начала кусков: bounds[0] = 0, последний элемент — input.size().
+     */
+    [[nodiscard]] std::vector<size_t> splitPoints(std::string_view input) const;
+
+    /**
+     * @brief Строки и столбцы токенов по их смещениям (параллельно по диапазонам токенов).
+     */
+    void fillLineColumns(std::string_view input, TokenStream &out, size_t parts) const;
+};
@@ -1,5 +1,9 @@
 // IReader.h
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
 
 class IReader {
 public:
@@ -9,4 +13,57 @@ public:
     [[nodiscard]] virtual bool isEOF() const = 0;
     [[nodiscard]] virtual int getLine() const = 0;
     [[nodiscard]] virtual int getColumn() const = 0;
+
+    /**
+     * @brief Байтовое смещение следующего символа от начала входа.
+     */
+    [[nodiscard]] virtual uint64_t getOffset() const = 0;
+
+    /**
+     * @brief true, если память окон, выданных window(), остаётся действительной
+     *        до уничтожения ридера (например, отображение файла целиком).
+     *        Тогда лексер может ссылаться на лексемы без копирования.
+     *        Такие окна — части одного непрерывного буфера со всем входом:
+     *        байт со смещением o лежит по адресу window().data() - getOffset() + o.
+     */
+    [[nodiscard]] virtual bool hasStableWindows() const { return false; }
+
+    /**
+     * @brief Непрерывное окно ещё не прочитанных символов, начиная с текущей позиции.
+     *        Окно действительно до следующего вызова любого неконстантного метода ридера.
+     *
+     * Пустое окно означает, что ридер не умеет отдавать символы пачкой (реализация
+     * по умолчанию) или вход закончился; в этом случае следует читать через peekChar/getChar.
+     */
+    virtual std::span<const char> window() { return {}; }
+
+    /**
+     * @brief Сдвигает позицию на n символов, обновляя line/column.
+     *        Реализация по умолчанию вызывает getChar() n раз.
+     * @param n Количество символов, не больше размера текущего окна.
+     */
+    virtual void advance(size_t n) {
+      for (size_t i = 0; i < n; ++i) {
+        getChar();
+      }
+    }
+
+    /**
+     * @brief Ставит контрольную точку в текущей позиции. До следующего mark() ридер
+     *        обязан уметь вернуться через reset() к любому смещению не меньше неё.
+     *        Лексер ставит точку в начале каждого токена.
+     */
+    virtual void mark() {}
+
+    /**
+     * @brief Возвращает позицию к смещению offset: контрольная точка <= offset <= getOffset().
+     *        Символы после offset будут прочитаны заново; признак EOF сбрасывается.
+     *        Реализация по умолчанию умеет только «вернуться» в текущую позицию.
+     * @throws std::runtime_error Если ридер не поддерживает возврат.
+     */
+    virtual void reset(uint64_t offset) {
+      if (offset != getOffset()) {
+        throw std::runtime_error("IReader: reset is not supported by this reader");
+      }
+    }
 };
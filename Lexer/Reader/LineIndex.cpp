@@ -0,0 +1,124 @@
+#include "LineIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LINE_INDEX_X86 1
+#else
+#define LINE_INDEX_X86 0
+#endif
+
+using CollectFn = void (*)(const char *, size_t, uint64_t, std::vector<uint64_t> &);
+
+static void collectScalar(const char *p, size_t n, uint64_t base, std::vector<uint64_t> &out) {
+  const char *end = p + n;
+  const char *nl = static_cast<const char*>(std::memchr(p, '\n', n));
+  while (nl) {
+    out.push_back(base + static_cast<uint64_t>(nl - p));
+    nl = static_cast<const char*>(std::memchr(nl + 1, '\n', static_cast<size_t>(end - nl - 1)));
+  }
+}
+
+#if LINE_INDEX_X86
+
+static void collectSse2(const char *p, size_t n, uint64_t base, std::vector<uint64_t> &out) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, newline)));
+    while (mask) {
+      out.push_back(base + i + static_cast<uint64_t>(__builtin_ctz(mask)));
+      mask &= mask - 1;
+    }
+  }
+  collectScalar(p + i, n - i, base + i, out);
+}
+
+__attribute__((target("avx2")))
+static void collectAvx2(const char *p, size_t n, uint64_t base, std::vector<uint64_t> &out) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, newline)));
+    while (mask) {
+      out.push_back(base + i + static_cast<uint64_t>(__builtin_ctz(mask)));
+      mask &= mask - 1;
+    }
+  }
+  collectSse2(p + i, n - i, base + i, out);
+}
+
+static CollectFn selectCollect() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return collectAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return collectSse2;
+  }
+  return collectScalar;
+}
+
+#else
+
+static CollectFn selectCollect() {
+  return collectScalar;
+}
+
+#endif
+
+LineIndex::LineIndex(std::string_view text) {
+  append(text.data(), text.size());
+}
+
+void LineIndex::append(const char *data, size_t n) {
+  static const CollectFn collect = selectCollect();
+  if (n == 0) {
+    return;
+  }
+  collect(data, n, m_size, m_newlines);
+  m_size += n;
+}
+
+TextPosition LineIndex::positionAfter(size_t newlinesBefore, uint64_t offset) const {
+  uint64_t start = newlinesBefore == 0 ? 0 : m_newlines[newlinesBefore - 1] + 1;
+  return {static_cast<uint64_t>(newlinesBefore) + 1, offset - start + 1};
+}
+
+TextPosition LineIndex::position(uint64_t offset) const {
+  auto it = std::lower_bound(m_newlines.begin(), m_newlines.end(), offset);
+  return positionAfter(static_cast<size_t>(it - m_newlines.begin()), offset);
+}
+
+TextPosition LineIndex::position(uint64_t offset, size_t &hint) const {
+  // hint — число переводов строки перед предыдущим запросом
+  const size_t count = m_newlines.size();
+  if (hint <= count && (hint == 0 || m_newlines[hint - 1] < offset)) {
+    for (size_t step = 0; step < 2; step++, hint++) {
+      if (hint == count || offset <= m_newlines[hint]) {
+        return positionAfter(hint, offset);
+      }
+    }
+  }
+  auto it = std::lower_bound(m_newlines.begin(), m_newlines.end(), offset);
+  hint = static_cast<size_t>(it - m_newlines.begin());
+  return positionAfter(hint, offset);
+}
+
+void LineIndex::advance(TextPosition &pos, const char *p, size_t n) {
+  const char *end = p + n;
+  while (const char *nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)))) {
+    pos.line++;
+    pos.column = 1;
+    p = nl + 1;
+  }
+  pos.column += static_cast<uint64_t>(end - p);
+}
+
+uint64_t LineIndex::lineStart(uint64_t line) const {
+  return line <= 1 ? 0 : m_newlines[static_cast<size_t>(line - 2)] + 1;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Строка и столбец байта (нумерация с 1, столбец — в байтах).
+ */
+struct TextPosition {
+    uint64_t line = 1;
+    uint64_t column = 1;
+};
+
+/**
+ * @brief Индекс переводов строк: смещения всех '\n' входа в порядке возрастания.
+ *
+ * Строится одним проходом (сравнение блоков по 16/32 байта с '\n' и перебор битов маски),
+ * после чего позиция любого смещения — бинарный поиск. Так лексеру не нужно считать
+ * строки и столбцы на каждом байте: позиция вычисляется, только когда её спросили.
+ * Смещения 64-битные, размер входа не ограничен 2 ГБ.
+ */
+class LineIndex {
+public:
+    LineIndex() = default;
+
+    /**
+     * @brief Индекс по всему тексту.
+     */
+    explicit LineIndex(std::string_view text);
+
+    /**
+     * @brief Дописывает в индекс следующие n байт входа (они идут сразу за уже проиндексированными).
+     */
+    void append(const char *data, size_t n);
+
+    /**
+     * @brief Позиция байта со смещением offset (offset не больше size()).
+     */
+    [[nodiscard]] TextPosition position(uint64_t offset) const;
+
+    /**
+     * @brief То же для почти монотонных запросов: hint — номер перевода строки, найденный
+     *        предыдущим запросом; если offset лежит в той же или следующей строке,
+     *        бинарный поиск не нужен. hint обновляется.
+     */
+    [[nodiscard]] TextPosition position(uint64_t offset, size_t &hint) const;
+
+    /**
+     * @brief Смещение начала строки line (с 1), line не больше lineCount().
+     */
+    [[nodiscard]] uint64_t lineStart(uint64_t line) const;
+
+    /**
+     * @brief Число строк проиндексированной части (переводов строки + 1).
+     */
+    [[nodiscard]] uint64_t lineCount() const { return m_newlines.size() + 1; }
+
+    /**
+     * @brief Сколько байт входа проиндексировано.
+     */
+    [[nodiscard]] uint64_t size() const { return m_size; }
+
+    [[nodiscard]] const std::vector<uint64_t> &newlines() const { return m_newlines; }
+
+    /**
+     * @brief Переносит позицию pos через n байт, начиная с p, без построения индекса —
+     *        для ридеров и лексеров, которые двигают одну позицию вперёд по входу.
+     */
+    static void advance(TextPosition &pos, const char *p, size_t n);
+
+private:
+    std::vector<uint64_t> m_newlines;
+    uint64_t m_size = 0;
+
+    /**
+     * @brief Позиция по числу переводов строки перед offset.
+     */
+    [[nodiscard]] TextPosition positionAfter(size_t newlinesBefore, uint64_t offset) const;
+};
@@ -0,0 +1,130 @@
+#include "MmapReader.h"
+#include <stdexcept>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MmapReader::MmapReader(const std::string &filePath)
+        : m_data(nullptr),
+          m_size(0),
+          m_pos(0),
+          m_eof(false),
+          m_linesBuilt(false),
+          m_lineHint(0) {
+  int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filePath);
+  }
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + filePath);
+  }
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size == 0) {
+    // mmap не умеет отображать пустой файл
+    ::close(fd);
+    m_eof = true;
+    return;
+  }
+  void *mapped = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // Отображение держит свою ссылку на файл, дескриптор больше не нужен
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    throw std::runtime_error("Failed to mmap file: " + filePath);
+  }
+  ::madvise(mapped, m_size, MADV_SEQUENTIAL);
+  m_data = static_cast<const char*>(mapped);
+}
+
+MmapReader::~MmapReader() {
+  if (m_data) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+  }
+}
+
+/**
+ * @brief Возвращает следующий символ и сдвигает позицию на 1.
+ */
+char MmapReader::getChar()
+{
+  if (m_pos >= m_size) {
+    m_eof = true;
+    return '\0';
+  }
+  return m_data[m_pos++];
+}
+
+/**
+ * @brief Возвращает символ на расстоянии offset от текущей позиции, не сдвигая её.
+ *        За пределами файла возвращает '\0'; peekChar(0) в конце файла выставляет EOF,
+ *        как и в TwoBufferReader.
+ */
+char MmapReader::peekChar(int offset)
+{
+  if (offset < 0) {
+    return '\0';
+  }
+  size_t pos = m_pos + static_cast<size_t>(offset);
+  if (pos >= m_size) {
+    if (offset == 0) {
+      m_eof = true;
+    }
+    return '\0';
+  }
+  return m_data[pos];
+}
+
+std::span<const char> MmapReader::window()
+{
+  return {m_data + m_pos, m_size - m_pos};
+}
+
+void MmapReader::advance(size_t n)
+{
+  if (n > m_size - m_pos) {
+    n = m_size - m_pos;
+  }
+  m_pos += n;
+}
+
+/**
+ * @brief Файл отображён целиком, поэтому вернуться можно к любому смещению.
+ */
+void MmapReader::reset(uint64_t offset)
+{
+  if (offset > m_size) {
+    throw std::runtime_error("MmapReader: reset past the end of file");
+  }
+  m_pos = static_cast<size_t>(offset);
+  // Пустой файл находится в состоянии EOF с момента создания
+  m_eof = m_size == 0;
+}
+
+const LineIndex &MmapReader::lineIndex() const
+{
+  if (!m_linesBuilt) {
+    m_lines = LineIndex(std::string_view(m_data, m_size));
+    m_linesBuilt = true;
+  }
+  return m_lines;
+}
+
+TextPosition MmapReader::currentPosition() const
+{
+  return lineIndex().position(m_pos, m_lineHint);
+}
+
+int MmapReader::getLine() const
+{
+  return static_cast<int>(currentPosition().line);
+}
+
+int MmapReader::getColumn() const
+{
+  return static_cast<int>(currentPosition().column);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "IReader.h"
+#include "LineIndex.h"
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Ридер, который один раз отображает весь файл в память (mmap)
+ *        и отдаёт символы прямо из отображения.
+ *
+ * Особенности:
+ *  - файл отображается целиком при создании ридера, дальнейших системных вызовов нет;
+ *  - ядру передаётся подсказка madvise(MADV_SEQUENTIAL), т.к. лексер читает вход последовательно;
+ *  - peekChar(offset) с любым offset — это просто обращение к m_data[m_pos + offset];
+ *  - для пустого файла отображение не создаётся, ридер сразу находится в состоянии EOF;
+ *  - mark() ничего не делает, reset() возвращается к любому смещению файла;
+ *  - строки и столбцы при чтении не считаются: при первом вопросе getLine()/getColumn()
+ *    строится LineIndex по всему файлу, дальше позиция ищется в нём.
+ */
+class MmapReader : public IReader {
+public:
+    /**
+     * @brief Открывает файл и отображает его в память.
+     * @param filePath Путь к файлу.
+     * @throws std::runtime_error Если файл не удалось открыть или отобразить.
+     */
+    explicit MmapReader(const std::string &filePath);
+
+    /**
+     * @brief Снимает отображение файла.
+     */
+    ~MmapReader() override;
+
+    MmapReader(const MmapReader &) = delete;
+    MmapReader &operator=(const MmapReader &) = delete;
+
+    char getChar() override;
+    char peekChar(int offset) override;
+    [[nodiscard]] bool isEOF() const override { return m_eof; }
+    [[nodiscard]] int getLine() const override;
+    [[nodiscard]] int getColumn() const override;
+    [[nodiscard]] uint64_t getOffset() const override { return m_pos; }
+    [[nodiscard]] bool hasStableWindows() const override { return true; }
+
+    /**
+     * @brief Окно — весь ещё не прочитанный остаток отображения.
+     */
+    std::span<const char> window() override;
+    void advance(size_t n) override;
+    void reset(uint64_t offset) override;
+
+    /**
+     * @brief Индекс переводов строк всего файла (строится при первом обращении).
+     */
+    [[nodiscard]] const LineIndex &lineIndex() const;
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool   m_eof;
+    mutable LineIndex m_lines;
+    mutable bool      m_linesBuilt;
+    mutable size_t    m_lineHint;   ///< Подсказка для почти монотонных запросов позиции
+
+    [[nodiscard]] TextPosition currentPosition() const;
+};
@@ -0,0 +1,149 @@
+#include "PipeReader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+PipeReader::PipeReader(int fd, size_t bufferSize)
+        : m_fd(fd),
+          m_bufferStart(0),
+          m_pos(0),
+          m_end(0),
+          m_marked(false),
+          m_markPos(0),
+          m_streamEnd(false),
+          m_eof(false),
+          m_cachedOffset(0) {
+  if (bufferSize == 0) {
+    throw std::runtime_error("PipeReader: buffer size must be positive");
+  }
+  m_buffer.resize(bufferSize);
+}
+
+bool PipeReader::fill()
+{
+  if (m_streamEnd) {
+    return false;
+  }
+  if (m_end == m_buffer.size()) {
+    // Байты левее контрольной точки (или текущей позиции, если точки нет) больше не нужны
+    size_t keepFrom = m_marked ? static_cast<size_t>(m_markPos - m_bufferStart) : m_pos;
+    if (keepFrom > 0) {
+      LineIndex::advance(m_startPosition, m_buffer.data(), keepFrom);
+      std::memmove(m_buffer.data(), m_buffer.data() + keepFrom, m_end - keepFrom);
+      m_bufferStart += keepFrom;
+      m_pos -= keepFrom;
+      m_end -= keepFrom;
+      if (m_cachedOffset < m_bufferStart) {
+        m_cachedOffset = m_bufferStart;
+        m_cachedPosition = m_startPosition;
+      }
+    }
+    // Токен занимает больше половины буфера — растим, чтобы сдвиг не повторялся на каждом read()
+    if (m_end == m_buffer.size() || m_buffer.size() - m_end < m_buffer.size() / 2) {
+      m_buffer.resize(m_buffer.size() * 2);
+    }
+  }
+  for (;;) {
+    ssize_t n = ::read(m_fd, m_buffer.data() + m_end, m_buffer.size() - m_end);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      throw std::runtime_error(std::string("PipeReader: read failed: ") + std::strerror(errno));
+    }
+    if (n == 0) {
+      m_streamEnd = true;
+      return false;
+    }
+    m_end += static_cast<size_t>(n);
+    return true;
+  }
+}
+
+char PipeReader::getChar()
+{
+  if (m_pos == m_end && !fill()) {
+    m_eof = true;
+    return '\0';
+  }
+  return m_buffer[m_pos++];
+}
+
+/**
+ * @brief Символ на расстоянии offset от текущей позиции; при необходимости дочитывает вход.
+ *        peekChar(0) в конце входа выставляет EOF, как и у остальных ридеров.
+ */
+char PipeReader::peekChar(int offset)
+{
+  if (offset < 0) {
+    return '\0';
+  }
+  auto ahead = static_cast<size_t>(offset);
+  while (m_end - m_pos <= ahead) {
+    if (!fill()) {
+      if (offset == 0) {
+        m_eof = true;
+      }
+      return '\0';
+    }
+  }
+  return m_buffer[m_pos + ahead];
+}
+
+std::span<const char> PipeReader::window()
+{
+  if (m_pos == m_end && !fill()) {
+    return {};
+  }
+  return {m_buffer.data() + m_pos, m_end - m_pos};
+}
+
+void PipeReader::advance(size_t n)
+{
+  if (n > m_end - m_pos) {
+    n = m_end - m_pos;
+  }
+  m_pos += n;
+}
+
+void PipeReader::mark()
+{
+  m_marked = true;
+  m_markPos = getOffset();
+}
+
+void PipeReader::reset(uint64_t offset)
+{
+  uint64_t lowest = m_marked ? m_markPos : getOffset();
+  if (offset < lowest || offset > getOffset()) {
+    throw std::runtime_error("PipeReader: reset outside of the marked range");
+  }
+  m_pos = static_cast<size_t>(offset - m_bufferStart);
+  m_eof = false;
+}
+
+TextPosition PipeReader::currentPosition() const
+{
+  uint64_t offset = getOffset();
+  if (offset < m_cachedOffset) {
+    m_cachedOffset = m_bufferStart;
+    m_cachedPosition = m_startPosition;
+  }
+  LineIndex::advance(m_cachedPosition, m_buffer.data() + (m_cachedOffset - m_bufferStart),
+                  static_cast<size_t>(offset - m_cachedOffset));
+  m_cachedOffset = offset;
+  return m_cachedPosition;
+}
+
+int PipeReader::getLine() const
+{
+  return static_cast<int>(currentPosition().line);
+}
+
+int PipeReader::getColumn() const
+{
+  return static_cast<int>(currentPosition().column);
+}
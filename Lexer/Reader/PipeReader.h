@@ -0,0 +1,68 @@
+#pragma once
+#include "IReader.h"
+#include "LineIndex.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Ридер из канала или любого другого дескриптора, который можно только читать
+ *        последовательно (без lseek/pread), — например, вывода препроцессора.
+ *
+ * Особенности:
+ *  - байты читаются read() в собственный буфер; окно — прочитанная, но ещё не разобранная
+ *    часть буфера;
+ *  - буфер хранит байты только от контрольной точки mark() (начала текущего токена):
+ *    перед очередным read() всё, что левее, сдвигается из буфера. Буфер растёт, лишь
+ *    если один токен вместе с просмотром вперёд длиннее него, поэтому память ограничена
+ *    размером буфера и самого длинного токена, а не размером входа;
+ *  - без mark() reset() возможен только в текущую позицию;
+ *  - строка и столбец считаются по буферу от позиции его начала, которая сдвигается
+ *    вместе с ним; запросы с неубывающими смещениями обходятся в один проход по входу.
+ *
+ * Дескриптор ридеру не принадлежит и не закрывается им.
+ */
+class PipeReader : public IReader {
+public:
+    /**
+     * @param fd Дескриптор, открытый на чтение
+     * @param bufferSize Начальный размер буфера
+     * @throws std::runtime_error Если bufferSize == 0.
+     */
+    explicit PipeReader(int fd, size_t bufferSize = 1 << 16);
+
+    char getChar() override;
+    char peekChar(int offset) override;
+    [[nodiscard]] bool isEOF() const override { return m_eof; }
+    [[nodiscard]] int getLine() const override;
+    [[nodiscard]] int getColumn() const override;
+    [[nodiscard]] uint64_t getOffset() const override { return m_bufferStart + m_pos; }
+
+    std::span<const char> window() override;
+    void advance(size_t n) override;
+    void mark() override;
+    void reset(uint64_t offset) override;
+
+private:
+    int m_fd;
+    std::vector<char> m_buffer;
+    uint64_t m_bufferStart;   ///< Смещение входа, с которого начинается m_buffer
+    size_t m_pos;             ///< Индекс следующего символа в m_buffer
+    size_t m_end;             ///< Сколько байт m_buffer заполнено
+    bool m_marked;
+    uint64_t m_markPos;
+    bool m_streamEnd;         ///< read() вернул 0: больше данных не будет
+    bool m_eof;               ///< Была попытка прочитать за концом входа
+    TextPosition m_startPosition;                ///< Позиция байта m_bufferStart
+    mutable uint64_t m_cachedOffset;             ///< Последний ответ на запрос позиции
+    mutable TextPosition m_cachedPosition;
+
+    /**
+     * @brief Дочитывает данные в буфер (сдвинув из него байты левее контрольной точки).
+     * @return false, если вход закончился.
+     * @throws std::runtime_error Если read() завершился ошибкой.
+     */
+    bool fill();
+
+    [[nodiscard]] TextPosition currentPosition() const;
+};
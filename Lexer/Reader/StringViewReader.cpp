@@ -0,0 +1,74 @@
+#include "StringViewReader.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+StringViewReader::StringViewReader(std::string_view text, size_t pos)
+        : m_text(text),
+          m_pos(std::min(pos, text.size())),
+          m_eof(false),
+          m_cachedOffset(0) {}
+
+char StringViewReader::getChar()
+{
+  if (m_pos >= m_text.size()) {
+    m_eof = true;
+    return '\0';
+  }
+  return m_text[m_pos++];
+}
+
+char StringViewReader::peekChar(int offset)
+{
+  if (offset < 0) {
+    return '\0';
+  }
+  size_t pos = m_pos + static_cast<size_t>(offset);
+  if (pos >= m_text.size()) {
+    if (offset == 0) {
+      m_eof = true;
+    }
+    return '\0';
+  }
+  return m_text[pos];
+}
+
+std::span<const char> StringViewReader::window()
+{
+  return {m_text.data() + m_pos, m_text.size() - m_pos};
+}
+
+void StringViewReader::advance(size_t n)
+{
+  m_pos += std::min(n, m_text.size() - m_pos);
+}
+
+void StringViewReader::reset(uint64_t offset)
+{
+  if (offset > m_text.size()) {
+    throw std::runtime_error("StringViewReader: reset beyond the end of the text");
+  }
+  m_pos = static_cast<size_t>(offset);
+  m_eof = false;
+}
+
+TextPosition StringViewReader::currentPosition() const
+{
+  if (m_pos < m_cachedOffset) {
+    m_cachedOffset = 0;
+    m_cachedPosition = TextPosition{};
+  }
+  LineIndex::advance(m_cachedPosition, m_text.data() + m_cachedOffset, m_pos - m_cachedOffset);
+  m_cachedOffset = m_pos;
+  return m_cachedPosition;
+}
+
+int StringViewReader::getLine() const
+{
+  return static_cast<int>(currentPosition().line);
+}
+
+int StringViewReader::getColumn() const
+{
+  return static_cast<int>(currentPosition().column);
+}
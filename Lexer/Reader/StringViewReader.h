@@ -0,0 +1,49 @@
+#pragma once
+#include "IReader.h"
+#include "LineIndex.h"
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Ридер по тексту, который уже лежит в памяти и принадлежит вызывающему.
+ *
+ * Особенности:
+ *  - текст не копируется: окно — весь непрочитанный остаток, окна стабильны
+ *    (hasStableWindows()), поэтому лексемы ссылаются прямо на текст;
+ *  - reset() возможен на любое смещение текста;
+ *  - ридер ничего не выделяет: строка и столбец считаются по тексту от последней
+ *    запрошенной позиции, так что запросы с неубывающими смещениями обходятся в один
+ *    проход по входу.
+ *
+ * Текст должен жить дольше ридера и токенов, которые на него ссылаются.
+ */
+class StringViewReader : public IReader {
+public:
+    /**
+     * @param text Входной текст
+     * @param pos Смещение, с которого начинается чтение (позиции считаются от начала text)
+     */
+    explicit StringViewReader(std::string_view text, size_t pos = 0);
+
+    char getChar() override;
+    char peekChar(int offset) override;
+    [[nodiscard]] bool isEOF() const override { return m_eof; }
+    [[nodiscard]] int getLine() const override;
+    [[nodiscard]] int getColumn() const override;
+    [[nodiscard]] uint64_t getOffset() const override { return m_pos; }
+    [[nodiscard]] bool hasStableWindows() const override { return true; }
+
+    std::span<const char> window() override;
+    void advance(size_t n) override;
+    void reset(uint64_t offset) override;
+
+private:
+    std::string_view m_text;
+    size_t m_pos;
+    bool m_eof;
+    mutable size_t m_cachedOffset;          ///< Смещение последнего ответа на запрос позиции
+    mutable TextPosition m_cachedPosition;
+
+    [[nodiscard]] TextPosition currentPosition() const;
+};
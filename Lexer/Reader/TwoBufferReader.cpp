@@ -1,108 +1,238 @@
 #include "TwoBufferReader.h"
 #include <stdexcept>
-#include <cstring> // для std::memcpy в случае надобности
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 TwoBufferReader::TwoBufferReader(const std::string &filePath, size_t bufferSize)
-        : m_file(nullptr),
+        : m_fd(-1),
           m_bufferSize(bufferSize),
-          m_bufferData(nullptr),
-          m_bufferStart(0),
-          m_bufferCount(0),
+          m_buffer(nullptr),
+          m_halfStart{0, 0},
+          m_halfCount{0, 0},
+          m_halfLoaded{false, false},
+          m_cur(0),
+          m_forward(0),
           m_globalPos(0),
           m_eof(false),
-          m_line(1),
-          m_column(1) {
-  m_file = std::fopen(filePath.c_str(), "r");
-  if (!m_file) {
+          m_markPos(0),
+          m_lineHint(0) {
+  if (m_bufferSize == 0) {
+    throw std::runtime_error("TwoBufferReader: buffer size must be positive");
+  }
+  m_fd = ::open(filePath.c_str(), O_RDONLY);
+  if (m_fd < 0) {
     throw std::runtime_error("Failed to open file: " + filePath);
   }
-  m_bufferData = new char[m_bufferSize];
+  ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  m_buffer = new char[2 * (m_bufferSize + 1)];
+  loadHalf(0, 0);
 }
 
 TwoBufferReader::~TwoBufferReader() {
-  if (m_file) {
-    std::fclose(m_file);
-    m_file = nullptr;
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
   }
-  delete[] m_bufferData;
+  delete[] m_buffer;
 }
 
-void TwoBufferReader::loadBuffer(size_t newStart) {
-  if (std::fseek(m_file, static_cast<long>(newStart), SEEK_SET) != 0) {
-    m_bufferCount = 0;
-    m_eof = true;
-    return;
-  }
-  size_t bytesRead = std::fread(m_bufferData, 1, m_bufferSize, m_file);
-  m_bufferStart  = newStart;
-  m_bufferCount  = bytesRead;
-  if (bytesRead == 0) {
-    m_eof = true;
+void TwoBufferReader::loadHalf(int h, size_t fileOffset) {
+  char *dst = m_buffer + halfBase(h);
+  size_t total = 0;
+  while (total < m_bufferSize) {
+    ssize_t n = ::pread(m_fd, dst + total, m_bufferSize - total,
+                        static_cast<off_t>(fileOffset + total));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    total += static_cast<size_t>(n);
+  }
+  dst[total] = '\0';
+  if (fileOffset + total > m_lines.size() && fileOffset <= m_lines.size()) {
+    // Половины загружаются по возрастанию смещений; в индекс идёт только новая часть
+    size_t skip = static_cast<size_t>(m_lines.size() - fileOffset);
+    m_lines.append(dst + skip, total - skip);
+  }
+  m_halfStart[h]  = fileOffset;
+  m_halfCount[h]  = total;
+  m_halfLoaded[h] = true;
+  if (total == m_bufferSize) {
+    // Пока лексер разбирает эту половину, ядро дочитывает следующую
+    ::posix_fadvise(m_fd, static_cast<off_t>(fileOffset + m_bufferSize),
+                    static_cast<off_t>(m_bufferSize), POSIX_FADV_WILLNEED);
   }
 }
 
-/**
- * @brief Возвращает символ из глобальной позиции pos, не изменяя счётчиков строк/столбцов
- *        и не меняя m_globalPos. Если pos вне файла, вернёт '\0'. Если нужно, подгружает буфер.
- */
-char TwoBufferReader::getCharAt(size_t pos) const
-{
-  if (m_eof && pos >= (m_bufferStart + m_bufferCount)) {
-    return '\0';
-  }
-  if (pos < m_bufferStart || pos >= (m_bufferStart + m_bufferCount)) {
-    auto self = const_cast<TwoBufferReader*>(this);
-    self->loadBuffer(pos);
-    if (m_bufferCount == 0 || pos < m_bufferStart || pos >= (m_bufferStart + m_bufferCount)) {
-      return '\0';
+int TwoBufferReader::halfFor(size_t pos) {
+  for (int h = 0; h < 2; ++h) {
+    if (m_halfLoaded[h] && pos >= m_halfStart[h] && pos < m_halfStart[h] + m_halfCount[h]) {
+      return h;
     }
   }
-  size_t offsetInBuf = pos - m_bufferStart;
-  return m_bufferData[offsetInBuf];
+  if (m_halfCount[m_cur] != m_bufferSize) {
+    return -1; // текущая половина — последняя в файле
+  }
+  size_t nextStart = m_halfStart[m_cur] + m_bufferSize;
+  if (pos < nextStart || pos >= nextStart + m_bufferSize) {
+    return -1;
+  }
+  int other = 1 - m_cur;
+  if (!m_halfLoaded[other] || m_halfStart[other] != nextStart) {
+    loadHalf(other, nextStart);
+  }
+  return pos < nextStart + m_halfCount[other] ? other : -1;
+}
+
+TextPosition TwoBufferReader::currentPosition() const {
+  return m_lines.position(m_globalPos, m_lineHint);
+}
+
+int TwoBufferReader::getLine() const {
+  return static_cast<int>(currentPosition().line);
+}
+
+int TwoBufferReader::getColumn() const {
+  return static_cast<int>(currentPosition().column);
 }
 
 /**
- * @brief Аналог getCharAt, но дополнительно обновляет m_line/m_column (как будто «прочитали» символ).
- *        m_globalPos НЕ сдвигаем.
+ * @brief Возвращает следующий символ и смещает позицию на 1.
+ *        Горячий путь — одна проверка на страж.
  */
-char TwoBufferReader::consumeCharAt(size_t pos)
+char TwoBufferReader::getChar()
 {
-  char c = getCharAt(pos);
-  if (c == '\n') {
-    m_line++;
-    m_column = 1;
-  } else if (c != '\0') {
-    m_column++;
+  char c = m_buffer[m_forward];
+  if (c == '\0') {
+    return getCharSlow();
   }
+  m_forward++;
+  m_globalPos++;
   return c;
 }
 
-/**
- * @brief Возвращает следующий символ (по m_globalPos) и смещает m_globalPos на 1, обновляя line/column.
- */
-char TwoBufferReader::getChar()
+char TwoBufferReader::getCharSlow()
 {
   if (m_eof) {
     return '\0';
   }
-  char c = consumeCharAt(m_globalPos);
-  if (c == '\0') {
-    m_eof = true;
+  // Страж стоит ровно за последним реальным байтом половины; '\0' раньше — байт файла
+  bool atHalfEnd = m_forward == halfBase(m_cur) + m_halfCount[m_cur];
+  if (!atHalfEnd) {
+    m_forward++;
+    m_globalPos++;
     return '\0';
   }
-  m_globalPos++;
-  return c;
+  if (m_halfCount[m_cur] == m_bufferSize) {
+    int h = halfFor(m_globalPos);
+    if (h >= 0) {
+      m_cur = h;
+      m_forward = halfBase(h) + (m_globalPos - m_halfStart[h]);
+      return getChar();
+    }
+  }
+  // Страж в конце неполной половины — конец файла
+  m_eof = true;
+  return '\0';
 }
 
 /**
- * @brief Возвращает символ на расстоянии offset от m_globalPos, не продвигая m_globalPos,
- *        но обновлять line/column мы не должны (ведь это просто "подсмотреть").
+ * @brief Возвращает символ на расстоянии offset от текущей позиции, не продвигая её. Если байт не помещается в две половины буфера,
+ *        он читается отдельным pread(), не трогая буфер.
  */
 char TwoBufferReader::peekChar(int offset)
 {
   if (offset < 0) {
     return '\0';
   }
+  size_t idx = m_forward + static_cast<size_t>(offset);
+  if (idx < halfBase(m_cur) + m_halfCount[m_cur]) {
+    return m_buffer[idx];
+  }
   size_t pos = m_globalPos + static_cast<size_t>(offset);
-  return getCharAt(pos);
+  int h = halfFor(pos);
+  if (h >= 0) {
+    return m_buffer[halfBase(h) + (pos - m_halfStart[h])];
+  }
+  char c = '\0';
+  ssize_t n = -1;
+  if (m_halfCount[m_cur] == m_bufferSize) {
+    do {
+      n = ::pread(m_fd, &c, 1, static_cast<off_t>(pos));
+    } while (n < 0 && errno == EINTR);
+  }
+  if (n <= 0) {
+    if (offset == 0) {
+      m_eof = true;
+    }
+    return '\0';
+  }
+  return c;
+}
+
+std::span<const char> TwoBufferReader::window()
+{
+  size_t halfEnd = halfBase(m_cur) + m_halfCount[m_cur];
+  if (m_forward == halfEnd && !m_eof) {
+    int h = halfFor(m_globalPos);
+    if (h < 0) {
+      return {};
+    }
+    m_cur = h;
+    m_forward = halfBase(h) + (m_globalPos - m_halfStart[h]);
+    halfEnd = halfBase(h) + m_halfCount[h];
+  }
+  return {m_buffer + m_forward, halfEnd - m_forward};
+}
+
+void TwoBufferReader::advance(size_t n)
+{
+  size_t halfEnd = halfBase(m_cur) + m_halfCount[m_cur];
+  if (n > halfEnd - m_forward) {
+    n = halfEnd - m_forward;
+  }
+  m_forward += n;
+  m_globalPos += n;
+}
+
+void TwoBufferReader::mark()
+{
+  m_markPos = m_globalPos;
+}
+
+/**
+ * @brief Возвращается к offset внутри буфера; если половину с offset уже перезаписала
+ *        следующая (от точки ушли дальше, чем на целую половину), перечитывает её.
+ */
+void TwoBufferReader::reset(uint64_t offset)
+{
+  if (offset < m_markPos || offset > m_globalPos) {
+    throw std::runtime_error("TwoBufferReader: reset outside of the marked range");
+  }
+  size_t pos = static_cast<size_t>(offset);
+  int h = -1;
+  for (int i = 0; i < 2 && h < 0; ++i) {
+    if (m_halfLoaded[i] && pos >= m_halfStart[i] && pos < m_halfStart[i] + m_halfCount[i]) {
+      h = i;
+    }
+  }
+  // Позиция сразу за последним байтом половины тоже допустима: window() перейдёт дальше
+  for (int i = 0; i < 2 && h < 0; ++i) {
+    if (m_halfLoaded[i] && pos == m_halfStart[i] + m_halfCount[i]) {
+      h = i;
+    }
+  }
+  if (h < 0) {
+    h = m_cur;
+    loadHalf(h, pos / m_bufferSize * m_bufferSize);
+  }
+  m_cur = h;
+  m_forward = halfBase(h) + (pos - m_halfStart[h]);
+  m_globalPos = pos;
+  m_eof = false;
 }
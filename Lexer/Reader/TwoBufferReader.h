@@ -1,30 +1,41 @@
 #pragma once
 #include "IReader.h"
+#include "LineIndex.h"
 
 #include <string>
-#include <cstdio>
+#include <cstddef>
 
 /**
- * @brief Класс для посимвольного чтения файла с использованием «двух буферов» поочередно,
- *        но в коде ниже это фактически один массив, который мы перезагружаем кусками;
- *        логика "двух буферов" / double buffering скрыта внутри.
+ * @brief Класс для посимвольного чтения файла по классической схеме «двух буферов»
+ *        из книги дракона: буфер разделён на две половины, каждая заканчивается
+ *        символом-стражем '\0'.
  *
  * Особенности:
- *  - m_globalPos: абсолютная позиция от начала файла (какой символ следующий).
- *  - m_bufferStart: с какого глобального байта мы загрузили текущую партию.
- *  - m_bufferData: сюда грузим до bufferSize байт из файла (как «один» буфер).
- *  - m_bufferCount: сколько реальных байт загружено (меньше или равно bufferSize).
- *  - метод loadBuffer(newStart) загружает кусок из файла, начиная с байта newStart.
- *  - getChar()/peekChar(offset) обращаются к функции getCharAt(pos), которая при необходимости подгружает новый кусок.
- *
- *  Благодаря этому, тесты на peekChar(0) и т. д. будут корректно работать на стыках.
+ *  - m_buffer: 2 * (bufferSize + 1) байт; половина h занимает
+ *    [h * (bufferSize + 1), h * (bufferSize + 1) + bufferSize), за ней стоит страж.
+ *  - m_halfStart[h] / m_halfCount[h]: с какого байта файла загружена половина и сколько
+ *    реальных байт в ней; страж пишется сразу после последнего реального байта.
+ *  - m_forward: индекс следующего символа в m_buffer. В горячем пути getChar() проверяет
+ *    только один байт: если это не страж, символ сразу отдаётся.
+ *  - Страж отличается от байта '\0' в самом файле по позиции: он стоит сразу за
+ *    m_halfCount[h] реальными байтами. Встретив страж в конце заполненной половины,
+ *    ридер переключается на другую половину, загружая её при необходимости; страж
+ *    в конце неполной половины означает конец файла, а '\0' до него — обычный символ.
+ *  - Загрузка половины — один pread() по абсолютному смещению (без fseek); после неё ядру
+ *    передаётся posix_fadvise(WILLNEED) на следующую половину, так что чтение с диска
+ *    идёт в фоне, пока лексер разбирает текущую.
+ *  - mark()/reset(): возврат к смещению после контрольной точки обходится без чтения
+ *    с диска, пока обе половины ещё держат байты от неё (от точки ушли не дальше
+ *    конца следующей половины); иначе нужная половина перечитывается.
+ *  - Строки и столбцы на каждом байте не считаются: каждая впервые загруженная половина
+ *    одним проходом дописывается в LineIndex, позиция ищется в нём по запросу.
  */
 class TwoBufferReader : public IReader {
 public:
     /**
-     * @brief Создает ридер, читающий указанный файл с использованием буфера.
+     * @brief Создает ридер, читающий указанный файл с использованием двух половин буфера.
      * @param filePath Путь к файлу.
-     * @param bufferSize Размер внутреннего буфера, по умолчанию 4096 байт.
+     * @param bufferSize Размер одной половины буфера, по умолчанию 4096 байт.
      * @throws std::runtime_error Если файл не удалось открыть.
      */
     explicit TwoBufferReader(const std::string &filePath, size_t bufferSize = 4096);
@@ -34,41 +45,66 @@ public:
      */
     ~TwoBufferReader() override;
 
+    TwoBufferReader(const TwoBufferReader &) = delete;
+    TwoBufferReader &operator=(const TwoBufferReader &) = delete;
+
     char getChar() override;
     char peekChar(int offset) override;
     [[nodiscard]] bool isEOF() const override { return m_eof; }
-    [[nodiscard]] int getLine() const override { return m_line; }
-    [[nodiscard]] int getColumn() const override { return m_column; }
+    [[nodiscard]] int getLine() const override;
+    [[nodiscard]] int getColumn() const override;
+    [[nodiscard]] uint64_t getOffset() const override { return m_globalPos; }
+
+    /**
+     * @brief Окно — остаток текущей половины (до стража). Если текущая половина
+     *        дочитана, сначала переключается на следующую.
+     */
+    std::span<const char> window() override;
+    void advance(size_t n) override;
+    void mark() override;
+    void reset(uint64_t offset) override;
+
+    /**
+     * @brief Индекс переводов строк уже загруженной части файла (всё до getOffset() включительно).
+     */
+    [[nodiscard]] const LineIndex &lineIndex() const { return m_lines; }
 
 private:
-    FILE* m_file;
+    int    m_fd;
     const size_t m_bufferSize;
-    char*  m_bufferData;
-    size_t m_bufferStart;
-    size_t m_bufferCount;
+    char*  m_buffer;
+    size_t m_halfStart[2];
+    size_t m_halfCount[2];
+    bool   m_halfLoaded[2];
+    int    m_cur;
+    size_t m_forward;
     size_t m_globalPos;
     bool   m_eof;
-    int    m_line;
-    int    m_column;
+    size_t m_markPos;            ///< Контрольная точка mark(): reset() не уходит левее
+    LineIndex      m_lines;
+    mutable size_t m_lineHint;   ///< Подсказка для почти монотонных запросов позиции
 
     /**
-     * @brief Загружает в m_bufferData кусок файла, начиная с байта newStart (глобальной позиции).
-     *        Заполняет m_bufferData[0..m_bufferCount-1].
-     *        Если ничего не прочитали, выставляет m_eof=true.
+     * @brief Индекс начала половины h внутри m_buffer.
      */
-    void loadBuffer(size_t newStart);
+    [[nodiscard]] size_t halfBase(int h) const { return static_cast<size_t>(h) * (m_bufferSize + 1); }
 
     /**
-     * @brief Доступ к символу в глобальной позиции pos (не продвигая m_globalPos).
-     *        Если pos выходит за границы текущего загруженного буфера, buffer перезагружается.
-     *        Если файл закончился, вернёт '\0'.
+     * @brief Загружает в половину h до bufferSize байт файла, начиная с байта fileOffset,
+     *        ставит страж после прочитанных байт и подсказывает ядру прочитать следующую половину.
      */
-    char getCharAt(size_t pos) const;
+    void loadHalf(int h, size_t fileOffset);
 
     /**
-     * @brief Служебный метод для «не константного» доступа (увеличения m_line, m_col),
-     *        но не сдвигая m_globalPos. Обычно используется внутри getChar().
+     * @brief Возвращает индекс половины, содержащей байт pos, загружая «следующую» половину,
+     *        если pos лежит сразу за текущей. Если pos недоступен через буфер, возвращает -1.
      */
-    char consumeCharAt(size_t pos);
-};
+    int halfFor(size_t pos);
+
+    /**
+     * @brief Медленный путь getChar(): встречен страж. Переключает половины или фиксирует EOF.
+     */
+    char getCharSlow();
 
+    [[nodiscard]] TextPosition currentPosition() const;
+};
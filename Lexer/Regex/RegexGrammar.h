@@ -0,0 +1,176 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Рекурсивный спуск по грамматике регулярных выражений, общий для всех
+ *        построителей: RegexParser строит по нему AST, ThompsonArena — сразу фрагменты NFA
+ *        (в том числе на этапе компиляции, см. ConstexprDFA.h).
+ *
+ * Грамматика:
+ *   alt  := cat ('|' cat)*
+ *   cat  := rep rep ...           (конкатенация сворачивается вправо: a(b(c)))
+ *   rep  := base ('*'|'+'|'?')*
+ *   base := '(' alt ')' | '[' класс ']' | '\' символ | буква/цифра | ε
+ *
+ * Builder задаёт тип узла Node и операции над узлами:
+ *   literal(char), epsilon(), charClass(const std::string &), concat(Node, Node),
+ *   alternate(Node, Node), star(Node), plus(Node), question(Node).
+ * В charClass() передаётся содержимое [...] с уже снятым экранированием.
+ */
+template <typename Builder>
+class RegexGrammar {
+public:
+    using Node = typename Builder::Node;
+
+    constexpr RegexGrammar(Builder &builder, std::string_view pattern)
+            : m_builder(builder),
+              m_pattern(pattern)
+    {}
+
+    /**
+     * @brief Разбирает всё выражение.
+     * @throws std::runtime_error При несоответствии синтаксису.
+     */
+    constexpr Node parse() {
+      Node root = parseAlt();
+      if (!eof()) {
+        throw std::runtime_error("Неожиданные символы после конца выражения: '"
+                                 + std::string(m_pattern.substr(m_pos)) + "'");
+      }
+      return root;
+    }
+
+private:
+    Builder &m_builder;
+    std::string_view m_pattern;
+    size_t m_pos = 0;
+
+    [[nodiscard]] constexpr bool eof() const { return m_pos >= m_pattern.size(); }
+    [[nodiscard]] constexpr char peek() const { return eof() ? '\0' : m_pattern[m_pos]; }
+    constexpr char get() { return eof() ? '\0' : m_pattern[m_pos++]; }
+
+    constexpr bool match(char c) {
+      if (peek() == c) {
+        get();
+        return true;
+      }
+      return false;
+    }
+
+    constexpr Node parseAlt() {
+      Node left = parseCat();
+      while (match('|')) {
+        Node right = parseCat();
+        left = m_builder.alternate(left, right);
+      }
+      return left;
+    }
+
+    constexpr Node parseCat() {
+      std::vector<Node> nodes;
+      nodes.push_back(parseRep());
+      for (;;) {
+        char c = peek();
+        if (c == '|' || c == ')' || c == '\0') {
+          break;
+        }
+        nodes.push_back(parseRep());
+      }
+      Node result = nodes.back();
+      for (int i = static_cast<int>(nodes.size()) - 2; i >= 0; i--) {
+        result = m_builder.concat(nodes[i], result);
+      }
+      return result;
+    }
+
+    constexpr Node parseRep() {
+      Node node = parseBase();
+      while (!eof()) {
+        char c = peek();
+        if (c == '*') {
+          get();
+          node = m_builder.star(node);
+        } else if (c == '+') {
+          get();
+          node = m_builder.plus(node);
+        } else if (c == '?') {
+          get();
+          node = m_builder.question(node);
+        } else {
+          break;
+        }
+      }
+      return node;
+    }
+
+    constexpr Node parseBase() {
+      char c = peek();
+      if (c == '(') {
+        get();
+        Node node = parseAlt();
+        if (!match(')')) {
+          throw std::runtime_error("Ожидалась ')' в группе");
+        }
+        return node;
+      }
+      if (c == '[') {
+        get();
+        return m_builder.charClass(parseCharClass());
+      }
+      if (c == '\\') {
+        get();
+        return m_builder.literal(parseEscaped());
+      }
+      if (c == '|' || c == ')' || c == '*' || c == '+' || c == '?' || c == '\0') {
+        return m_builder.epsilon();
+      }
+      if (!((c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') ||
+            (c >= '0' && c <= '9'))) {
+        throw std::runtime_error(std::string("Недопустимый символ '") + c + "' в шаблоне");
+      }
+      return m_builder.literal(get());
+    }
+
+    /**
+     * @brief Содержимое класса символов до ']' с уже снятым экранированием.
+     * @throws std::runtime_error Если нет ']'.
+     */
+    constexpr std::string parseCharClass() {
+      std::string result;
+      while (!eof()) {
+        char c = get();
+        if (c == ']') {
+          return result;
+        }
+        if (c == '\\') {
+          if (eof()) {
+            throw std::runtime_error("Ожидалась ']' (класс символов не закрыт)");
+          }
+          result.push_back(parseEscaped());
+        } else {
+          result.push_back(c);
+        }
+      }
+      throw std::runtime_error("Ожидалась ']' для класса символов, но конец строки");
+    }
+
+    /**
+     * @brief Экранированный символ после '\\': \n, \r, \t, остальные — сами по себе.
+     */
+    constexpr char parseEscaped() {
+      if (eof()) {
+        throw std::runtime_error("Неожиданный конец при парсинге экранированного символа");
+      }
+      char c = get();
+      switch (c) {
+        case 'n': return '\n';
+        case 'r': return '\r';
+        case 't': return '\t';
+        default: return c;
+      }
+    }
+};
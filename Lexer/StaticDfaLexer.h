@@ -0,0 +1,96 @@
+#pragma once
+#include "BasicDfaLexer.h"
+#include "DFA/ConstexprDFA.h"
+#include "DFA/DFAAccelerator.h"
+#include "Token/CompactToken.h"
+#include "TokenSpecification/TokenSpec.h"
+#include "Reader/IReader.h"
+#include "../SymbolTable/ISymbolTable.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Адаптер таблицы, построенной на этапе компиляции, для BasicDfaLexer.
+ *        Число классов и тип номера состояния — константы времени компиляции.
+ */
+template <const auto &Specs>
+class StaticDfaAutomaton {
+public:
+    static constexpr auto TABLE = makeStaticDFA<Specs>();
+    static constexpr bool STABLE_STATE_IDS = true;
+
+    [[nodiscard]] int start() const { return TABLE.startState; }
+    [[nodiscard]] int next(int state, unsigned char c) const { return TABLE.next(state, c); }
+    [[nodiscard]] int token(int state) const { return TABLE.acceptToken[state]; }
+    [[nodiscard]] size_t stateCount() const { return TABLE.STATE_COUNT; }
+};
+
+/**
+ * @brief DfaLexer, специализированный на DFA, построенном на этапе компиляции.
+ *
+ * Таблица переходов — static constexpr член (лежит в .rodata), число классов и тип
+ * номера состояния — константы времени компиляции, поэтому построения автомата при
+ * запуске нет. Токены и их границы совпадают с DfaLexer на тех же спецификациях.
+ * Цикл разбора — BasicDfaLexer, с ускорителем петель, построенным по таблице один раз
+ * на все лексеры с этими Specs.
+ *
+ * Пример:
+ *   static constexpr std::array<StaticTokenSpec, 2> SPECS = {{
+ *       {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false},
+ *       {"WHITESPACE", "[ \t\r\n]+", true},
+ *   }};
+ *   StaticDfaLexer<SPECS> lexer(reader, &symbolTable);
+ */
+template <const auto &Specs>
+class StaticDfaLexer : public BasicDfaLexer<StaticDfaAutomaton<Specs>> {
+public:
+    static constexpr auto TABLE = StaticDfaAutomaton<Specs>::TABLE;
+
+    static_assert(Specs.size() <= CompactToken::MAX_SPEC_COUNT, "Слишком много спецификаций токенов");
+
+    /**
+     * @param reader Источник символов
+     * @param symbolTable Указатель на таблицу символов (может быть nullptr)
+     */
+    StaticDfaLexer(IReader &reader, ISymbolTable *symbolTable)
+            : BasicDfaLexer<StaticDfaAutomaton<Specs>>(StaticDfaAutomaton<Specs>(), tokenSpecs(),
+                                                       &accelerator(), reader, symbolTable)
+    {}
+
+    /**
+     * @brief Имя типа токена по его typeId на этапе компиляции; у объекта лексера
+     *        по-прежнему есть typeName() из BasicDfaLexer.
+     */
+    [[nodiscard]] static constexpr std::string_view staticTypeName(uint16_t typeId) {
+      if (typeId < Specs.size()) {
+        return Specs[typeId].name;
+      }
+      return typeId == CompactToken::END_OF_FILE_TYPE ? "END_OF_FILE" : "UNKNOWN";
+    }
+
+    /**
+     * @brief Specs в виде TokenSpec (приоритет — индекс); строится один раз.
+     */
+    static const std::vector<TokenSpec> &tokenSpecs() {
+      static const std::vector<TokenSpec> specs = [] {
+          std::vector<TokenSpec> result;
+          for (size_t i = 0; i < Specs.size(); i++) {
+            result.push_back({std::string(Specs[i].name), std::string(Specs[i].regex), Specs[i].ignore,
+                              static_cast<int>(i)});
+          }
+          return result;
+      }();
+      return specs;
+    }
+
+private:
+    /**
+     * @brief Ускоритель петель по TABLE, общий для всех лексеров с этими Specs.
+     */
+    static const DFAAccelerator &accelerator() {
+      static const DFAAccelerator accel(TABLE.toDFA(), tokenSpecs());
+      return accel;
+    }
+};
@@ -0,0 +1,34 @@
+#include "StringLexer.h"
+#include "DfaLexer.h"
+#include "Reader/StringViewReader.h"
+
+#include <stdexcept>
+#include <string>
+
+StringLexer::StringLexer(const DFA &dfa, const std::vector<TokenSpec> &tokenSpecs)
+        : m_dfa(dfa),
+          m_tokenSpecs(tokenSpecs),
+          m_accel(dfa, tokenSpecs)
+{
+  if (m_tokenSpecs.size() > CompactToken::MAX_SPEC_COUNT) {
+    throw std::runtime_error("Слишком много спецификаций токенов: " + std::to_string(m_tokenSpecs.size()));
+  }
+}
+
+size_t StringLexer::tokenize(std::string_view input, TokenStream &out, ISymbolTable *symbolTable) const
+{
+  if (!out.empty() || !out.text.empty()) {
+    throw std::runtime_error("StringLexer::tokenize: output stream must be empty");
+  }
+  StringViewReader reader(input);
+  DfaLexer lexer(m_dfa, m_tokenSpecs, m_accel, reader, symbolTable);
+  out.source = input.data();
+  return lexer.tokenizeAll(out);
+}
+
+TokenStream StringLexer::tokenize(std::string_view input) const
+{
+  TokenStream out;
+  tokenize(input, out);
+  return out;
+}
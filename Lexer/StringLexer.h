@@ -0,0 +1,51 @@
+#pragma once
+#include "DFA/DFA.h"
+#include "DFA/DFAAccelerator.h"
+#include "Token/TokenStream.h"
+#include "TokenSpecification/TokenSpec.h"
+#include "../SymbolTable/ISymbolTable.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Разбивка на токены строк в памяти по готовому DFA — для большого числа
+ *        маленьких фрагментов (строк лога, ячеек, запросов).
+ *
+ * Всё, что не зависит от входа (ускоритель петель, поиск IDENT), строится один раз
+ * в конструкторе. Сам вызов tokenize() работает поверх StringViewReader и DfaLexer
+ * на стеке и не выделяет память сверх массивов выходного потока: если переиспользовать
+ * один TokenStream (clear() сохраняет ёмкость), после первых фрагментов выделений
+ * нет вовсе. Исключение — таблица символов, которая копирует новые идентификаторы.
+ */
+class StringLexer {
+public:
+    /**
+     * @param dfa Автомат (только читается)
+     * @param tokenSpecs Набор спецификаций токенов
+     * @throws std::runtime_error Если спецификаций больше, чем помещается в CompactToken::typeId.
+     */
+    StringLexer(const DFA &dfa, const std::vector<TokenSpec> &tokenSpecs);
+
+    /**
+     * @brief Разбивает input на токены и дописывает их в out (END_OF_FILE не пишется).
+     *
+     * Лексемы ссылаются на input (out.source), строки и столбцы считаются от начала input.
+     * @param out Пустой поток
+     * @param symbolTable Таблица символов для токенов IDENT (может быть nullptr)
+     * @return Сколько токенов добавлено.
+     * @throws std::runtime_error Если out не пуст.
+     */
+    size_t tokenize(std::string_view input, TokenStream &out, ISymbolTable *symbolTable = nullptr) const;
+
+    /**
+     * @brief То же, с новым потоком в результате.
+     */
+    [[nodiscard]] TokenStream tokenize(std::string_view input) const;
+
+private:
+    const DFA &m_dfa;
+    const std::vector<TokenSpec> &m_tokenSpecs;
+    DFAAccelerator m_accel;
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Компактный токен без собственных строк.
+ *
+ *  - typeId: индекс спецификации токена (в порядке TokenSpec), либо UNKNOWN_TYPE / END_OF_FILE_TYPE;
+ *  - lexeme: вид на байты лексемы — в стабильном буфере ридера (mmap) или во внутреннем
+ *    буфере лексера (тогда он действителен только до следующего вызова лексера);
+ *  - offset: байтовое смещение начала лексемы от начала входа.
+ */
+struct CompactToken {
+    static constexpr uint16_t UNKNOWN_TYPE     = 0xFFFE;
+    static constexpr uint16_t END_OF_FILE_TYPE = 0xFFFF;
+    /// Максимальное число спецификаций, которое можно закодировать в typeId.
+    static constexpr size_t MAX_SPEC_COUNT     = UNKNOWN_TYPE;
+
+    uint16_t typeId = UNKNOWN_TYPE;
+    std::string_view lexeme;
+    uint64_t offset = 0;
+    int line = 0;
+    int column = 0;
+    int symbolId = -1;
+};
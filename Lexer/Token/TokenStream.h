@@ -0,0 +1,100 @@
+#pragma once
+#include "CompactToken.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Последовательность токенов в виде параллельных массивов (struct-of-arrays).
+ *
+ * Токен i — это typeIds[i], offsets[i], lengths[i], lines[i], columns[i], symbolIds[i];
+ * потребитель, которому нужны, например, только типы, читает один плотный массив.
+ * END_OF_FILE в поток не попадает.
+ *
+ * Лексемы не хранятся по отдельности:
+ *  - если вход лежит в памяти целиком (source != nullptr), лексема — source + offsets[i];
+ *  - иначе байты лексем складываются подряд в text, начало i-й — textOffsets[i].
+ * Поток заполняется одним лексером; смешивать токены разных входов нельзя.
+ * Длины хранятся в 32 битах: лексема длиннее 4 ГиБ - 1 отвергается (lengthOf()).
+ */
+struct TokenStream {
+    std::vector<uint16_t> typeIds;
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> lengths;
+    std::vector<int> lines;
+    std::vector<int> columns;
+    std::vector<int> symbolIds;
+
+    const char *source = nullptr;        ///< Начало входа, если он доступен целиком
+    std::string text;                    ///< Байты лексем, если source == nullptr
+    std::vector<uint64_t> textOffsets;   ///< Начало лексемы в text, если source == nullptr
+
+    [[nodiscard]] size_t size() const { return typeIds.size(); }
+    [[nodiscard]] bool empty() const { return typeIds.empty(); }
+
+    /**
+     * @brief Лексема i-го токена (действительна, пока жив поток и вход source).
+     */
+    [[nodiscard]] std::string_view lexeme(size_t i) const {
+      const char *base = source ? source + offsets[i] : text.data() + textOffsets[i];
+      return {base, lengths[i]};
+    }
+
+    /**
+     * @brief Длина лексемы в виде элемента lengths.
+     * @throws std::runtime_error Если лексема не помещается в 32 бита.
+     */
+    static uint32_t lengthOf(std::string_view lexeme) {
+      if (lexeme.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("TokenStream: lexeme is too long: " + std::to_string(lexeme.size()) + " bytes");
+      }
+      return static_cast<uint32_t>(lexeme.size());
+    }
+
+    /**
+     * @brief Добавляет токен; лексема копируется в text, если у потока нет source.
+     * @throws std::runtime_error Если лексема длиннее 4 ГиБ - 1 (поток не меняется).
+     */
+    void push(const CompactToken &token) {
+      uint32_t length = lengthOf(token.lexeme);
+      typeIds.push_back(token.typeId);
+      offsets.push_back(token.offset);
+      lengths.push_back(length);
+      lines.push_back(token.line);
+      columns.push_back(token.column);
+      symbolIds.push_back(token.symbolId);
+      if (!source) {
+        textOffsets.push_back(text.size());
+        text.append(token.lexeme);
+      }
+    }
+
+    void reserve(size_t n) {
+      typeIds.reserve(n);
+      offsets.reserve(n);
+      lengths.reserve(n);
+      lines.reserve(n);
+      columns.reserve(n);
+      symbolIds.reserve(n);
+      if (!source) {
+        textOffsets.reserve(n);
+      }
+    }
+
+    void clear() {
+      typeIds.clear();
+      offsets.clear();
+      lengths.clear();
+      lines.clear();
+      columns.clear();
+      symbolIds.clear();
+      source = nullptr;
+      text.clear();
+      textOffsets.clear();
+    }
+};
@@ -1,5 +1,7 @@
 #pragma once
+#include <algorithm>
 #include <string>
+#include <vector>
 
 /**
  * @brief Описание спецификации одного токена: имя, регулярное выражение, флаг игнорирования и приоритет.
@@ -10,3 +12,15 @@ struct TokenSpec {
     bool ignore;
     int priority;
 };
+
+/**
+ * @brief Упорядочивает спецификации по приоритету (меньший — раньше); при равных приоритетах
+ *        сохраняется порядок файла. Позиция в результате — индекс токена в DFA: по нему
+ *        разрешается допуск при равной длине, нумеруются типы и строится ключ DFACache,
+ *        поэтому анализатор, AnalyzerDriver и LexerGenerator сортируют только так.
+ */
+inline void sortTokenSpecsByPriority(std::vector<TokenSpec> &specs) {
+  std::stable_sort(specs.begin(), specs.end(), [](const TokenSpec &a, const TokenSpec &b) {
+      return a.priority < b.priority;
+  });
+}
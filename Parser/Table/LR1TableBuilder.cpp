@@ -11,7 +11,7 @@ LRTable LR1TableBuilder::build(const Grammar &grammar) {
   m_table.goTo.clear();
   m_firstNT.clear();
   validateGrammarSymbols(grammar);
-  buildAugmentedGrammar(grammar);
+  m_augGrammar = augmentGrammar(grammar);
   computeAllFirstSets();
   LR1State startState;
   {
@@ -90,13 +90,14 @@ LRTable LR1TableBuilder::build(const Grammar &grammar) {
   return m_table;
 }
 
-void LR1TableBuilder::buildAugmentedGrammar(const Grammar &original) {
-  m_augGrammar = original;
+Grammar LR1TableBuilder::augmentGrammar(const Grammar &original) {
+  Grammar augmented = original;
   Production aug;
   aug.left = AUGMENTED_START;
   aug.right.push_back(original.startSymbol);
-  m_augGrammar.productions.insert(m_augGrammar.productions.begin(), aug);
-  m_augGrammar.nonterminals.insert(m_augGrammar.nonterminals.begin(), AUGMENTED_START);
+  augmented.productions.insert(augmented.productions.begin(), aug);
+  augmented.nonterminals.insert(augmented.nonterminals.begin(), AUGMENTED_START);
+  return augmented;
 }
 
 void LR1TableBuilder::validateGrammarSymbols(const Grammar &g) {
@@ -91,23 +91,27 @@ public:
      */
     LRTable build(const Grammar& grammar) override;
 
-private:
     static constexpr const char* END_OF_INPUT = "$";       ///< Маркер конца ввода.
     static constexpr const char* AUGMENTED_START = "S'";     ///< Дополнительный стартовый символ.
 
+    /**
+     * @brief Аугментированная грамматика: original с нулевой продукцией S' -> startSymbol.
+     *
+     * Номера продукций в построенной таблице (REDUCE) отсчитываются по ней, поэтому
+     * LRParser должен получать именно её.
+     *
+     * @param original Исходная грамматика.
+     */
+    static Grammar augmentGrammar(const Grammar &original);
+
+private:
+
     Grammar m_augGrammar;                        ///< Аугментированная грамматика.
     LRTable m_table;                             ///< Таблица разбора (ACTION и GOTO).
     std::vector<LR1State> m_states;                ///< Множество LR(1)-состояний.
     std::map<std::string, int> m_stateIndex;       ///< Отображение сериализованного состояния в его идентификатор.
     std::unordered_map<std::string, std::unordered_set<std::string>> m_firstNT; ///< FIRST-множества для нетерминалов.
 
-    /**
-     * @brief Формирует аугментированную грамматику, добавляя новую продукцию старта.
-     *
-     * @param original Исходная грамматика.
-     */
-    void buildAugmentedGrammar(const Grammar &original);
-
     /**
      * @brief Валидирует символы грамматики: проверяет, что все символы, используемые в продукциях,
      *        объявлены в списках терминалов или нетерминалов.
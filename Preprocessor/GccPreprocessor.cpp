@@ -4,6 +4,150 @@
 #include <stdexcept>     // std::runtime_error
 #include <sstream>       // std::ostringstream, std::istringstream
 #include <iostream>      // std::cerr
+#include <thread>        // std::thread
+#include <vector>
+
+#include <cerrno>
+#include <fcntl.h>       // pipe2
+#include <spawn.h>       // posix_spawnp
+#include <sys/wait.h>    // waitpid
+#include <unistd.h>      // read, write, close
+
+extern char **environ;
+
+/**
+ * @brief Пишет в fd все n байт, повторяя write() после частичной записи.
+ * @return false, если запись не удалась.
+ */
+static bool writeAll(int fd, const char *data, size_t n) {
+  while (n > 0) {
+    ssize_t written = ::write(fd, data, n);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    n -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+/**
+ * @brief Проверяет статус завершения gcc (в формате waitpid/pclose).
+ * @throws std::runtime_error С кодом выхода gcc или номером сигнала, убившего его.
+ */
+static void checkGccStatus(int status) {
+  if (status == -1) {
+    throw std::runtime_error("Failed to get GCC exit status");
+  }
+  if (WIFSIGNALED(status)) {
+    std::cerr << "[WARN] GccPreprocessor: gcc завершён сигналом " << WTERMSIG(status) << "\n";
+    throw std::runtime_error("GCC was killed by signal " + std::to_string(WTERMSIG(status)));
+  }
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    std::cerr << "[WARN] GccPreprocessor: gcc вернул код " << WEXITSTATUS(status) << "\n";
+    throw std::runtime_error("GCC return code is non-zero: " + std::to_string(WEXITSTATUS(status)));
+  }
+}
+
+/**
+ * @brief Запущенный gcc: канал gcc -> поток-фильтр -> канал потребителя.
+ *
+ * Фильтр делает то же, что filterPreprocessorDirectives(): пропускает строки, начинающиеся
+ * с '#', и дописывает перевод строки к последней строке без него.
+ */
+class GccStream final : public PreprocessorStream {
+public:
+    GccStream(pid_t pid, int gccOut, int readEnd, int writeEnd)
+            : m_pid(pid),
+              m_gccOut(gccOut),
+              m_readEnd(readEnd),
+              m_writeEnd(writeEnd),
+              m_filter([this] { filterLoop(); }) {}
+
+    ~GccStream() override {
+      try {
+        finish();
+      } catch (const std::exception &) {
+        // Ошибку gcc можно узнать только из finish(); в деструкторе её некому сообщить
+      }
+    }
+
+    [[nodiscard]] int fd() const override { return m_readEnd; }
+
+    void finish() override {
+      if (m_finished) {
+        return;
+      }
+      m_finished = true;
+      // Дочитываем остаток, чтобы фильтр не заблокировался на полном канале
+      char buffer[1 << 16];
+      for (;;) {
+        ssize_t n = ::read(m_readEnd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n <= 0) {
+          break;
+        }
+      }
+      m_filter.join();
+      ::close(m_readEnd);
+      int status = 0;
+      while (::waitpid(m_pid, &status, 0) < 0 && errno == EINTR) {
+      }
+      checkGccStatus(status);
+    }
+
+private:
+    pid_t m_pid;
+    int m_gccOut;
+    int m_readEnd;
+    int m_writeEnd;
+    bool m_finished = false;
+    std::thread m_filter;
+
+    void filterLoop() {
+      std::vector<char> in(1 << 16);
+      std::vector<char> out;
+      out.reserve(in.size() + 1);
+      bool lineStart = true;   // следующий байт начинает строку
+      bool skipping = false;   // внутри строки-директивы
+      bool writable = true;    // потребитель ещё читает
+      for (;;) {
+        ssize_t n = ::read(m_gccOut, in.data(), in.size());
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n <= 0) {
+          break;
+        }
+        out.clear();
+        for (ssize_t i = 0; i < n; i++) {
+          char c = in[static_cast<size_t>(i)];
+          if (lineStart && c == '#') {
+            skipping = true;
+          }
+          if (!skipping) {
+            out.push_back(c);
+          }
+          lineStart = c == '\n';
+          if (lineStart) {
+            skipping = false;
+          }
+        }
+        // Если писать некуда, всё равно читаем вывод gcc до конца, чтобы он завершился
+        writable = writable && writeAll(m_writeEnd, out.data(), out.size());
+      }
+      if (writable && !lineStart && !skipping) {
+        writeAll(m_writeEnd, "\n", 1);
+      }
+      ::close(m_gccOut);
+      ::close(m_writeEnd);
+    }
+};
 
 std::string GccPreprocessor::preprocessFile(const std::string& filePath) {
   std::string command = buildCommand(filePath);
@@ -12,6 +156,39 @@ std::string GccPreprocessor::preprocessFile(const std::string& filePath) {
   return filtered;
 }
 
+std::unique_ptr<PreprocessorStream> GccPreprocessor::openStream(const std::string& filePath) {
+  // Каналы с O_CLOEXEC: gcc получает только свой stdout
+  int gccPipe[2];
+  int outPipe[2];
+  if (::pipe2(gccPipe, O_CLOEXEC) != 0) {
+    throw std::runtime_error("Не удалось создать канал для gcc");
+  }
+  if (::pipe2(outPipe, O_CLOEXEC) != 0) {
+    ::close(gccPipe[0]);
+    ::close(gccPipe[1]);
+    throw std::runtime_error("Не удалось создать канал для gcc");
+  }
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, gccPipe[1], STDOUT_FILENO);
+  std::string gcc = "gcc";
+  std::string e = "-E";
+  std::string p = "-P";
+  std::string path = filePath;
+  char *argv[] = {gcc.data(), e.data(), p.data(), path.data(), nullptr};
+  pid_t pid = 0;
+  int rc = posix_spawnp(&pid, "gcc", &actions, nullptr, argv, environ);
+  posix_spawn_file_actions_destroy(&actions);
+  ::close(gccPipe[1]);
+  if (rc != 0) {
+    ::close(gccPipe[0]);
+    ::close(outPipe[0]);
+    ::close(outPipe[1]);
+    throw std::runtime_error("Не удалось запустить команду: gcc -E -P " + filePath);
+  }
+  return std::make_unique<GccStream>(pid, gccPipe[0], outPipe[0], outPipe[1]);
+}
+
 std::string GccPreprocessor::buildCommand(const std::string& filePath) const {
   return "gcc -E -P " + filePath;
 }
@@ -27,11 +204,7 @@ std::string GccPreprocessor::executeCommand(const std::string& command) const {
   while (fgets(buffer, bufferSize, pipe) != nullptr) {
     outputStream << buffer;
   }
-  int returnCode = pclose(pipe);
-  if (returnCode != 0) {
-    std::cerr << "[WARN] GccPreprocessor: gcc вернул код " << returnCode << "\n";
-    throw std::runtime_error("GCC return code is non-zero: " + std::to_string(returnCode));
-  }
+  checkGccStatus(pclose(pipe));
   return outputStream.str();
 }
 
@@ -19,6 +19,17 @@ public:
      */
     std::string preprocessFile(const std::string& filePath) override;
 
+    /**
+     * @brief Запускает gcc -E -P для указанного файла с выводом в канал.
+     *
+     * Строки-директивы убирает отдельный поток-фильтр между каналом gcc и каналом,
+     * который читает потребитель. Временных файлов и строки со всем выводом нет.
+     * Ошибка gcc (например, отсутствующий файл) сообщается из PreprocessorStream::finish().
+     * @param filePath Путь к исходному файлу.
+     * @throws std::runtime_error Если gcc не удалось запустить.
+     */
+    std::unique_ptr<PreprocessorStream> openStream(const std::string& filePath) override;
+
 private:
     /**
      * @brief Формирует команду для системного вызова gcc -E -P <file>.
@@ -1,6 +1,26 @@
 #pragma once
+#include <memory>
 #include <string>
 
+/**
+ * @brief Вывод запущенного препроцессора, который читается по мере его работы.
+ */
+class PreprocessorStream {
+public:
+    virtual ~PreprocessorStream() = default;
+
+    /**
+     * @brief Дескриптор для чтения результата (канал; lseek по нему невозможен).
+     */
+    [[nodiscard]] virtual int fd() const = 0;
+
+    /**
+     * @brief Дочитывает и закрывает вывод, дожидается завершения препроцессора.
+     * @throws std::runtime_error Если препроцессор завершился с ошибкой.
+     */
+    virtual void finish() = 0;
+};
+
 /**
  * @brief Интерфейс препроцессора, который выполняет предобработку исходного кода.
  */
@@ -15,4 +35,13 @@ public:
      * @throws std::runtime_error В случае, если выполнить препроцессор не удалось.
      */
     virtual std::string preprocessFile(const std::string& filePath) = 0;
+
+    /**
+     * @brief Запускает пред обработку заданного файла и сразу возвращает её вывод в виде
+     *        потока: результат можно разбирать, пока препроцессор ещё работает, не собирая
+     *        его целиком в памяти. Текст тот же, что у preprocessFile().
+     * @param filePath Путь к исходному файлу.
+     * @throws std::runtime_error Если препроцессор не удалось запустить.
+     */
+    virtual std::unique_ptr<PreprocessorStream> openStream(const std::string& filePath) = 0;
 };
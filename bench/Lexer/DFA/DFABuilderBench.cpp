@@ -0,0 +1,91 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../Lexer/Regex/RegexParser.h"
+#include "../../../Lexer/NFA/NFABuilder.h"
+#include "../../../Lexer/DFA/DFABuiler.h"
+#include "../../../Lexer/DFA/LazyDFA.h"
+
+/**
+ * @brief Замер времени построения NFA и DFA на большой C-подобной спецификации.
+ *
+ * Запуск: DFABuilderBench [extraTokens] [repeats]
+ *   extraTokens — сколько синтетических токенов добавить к базовой спецификации (по умолчанию 100);
+ *   repeats     — сколько раз повторить построение (по умолчанию 3), печатается лучшее время.
+ */
+
+static std::vector<std::string> makeSpecRegexes(int extraTokens) {
+  std::vector<std::string> regexes = {
+          "auto", "break", "case", "char", "const", "continue", "default", "do",
+          "double", "else", "enum", "extern", "float", "for", "goto", "if",
+          "inline", "int", "long", "register", "restrict", "return", "short", "signed",
+          "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+          "volatile", "while",
+          "[a-zA-Z_][a-zA-Z0-9_]*",
+          "[0-9]+",
+          "0[xX][0-9a-fA-F]+",
+          "[0-9]+[.][0-9]*([eE][+-]?[0-9]+)?",
+          "[\"]([a-zA-Z0-9_ ,.;:!?]|[\\\\][nrt\"])*[\"]",
+          "[ \t\r\n]+",
+          "[+][+]", "[-][-]", "[+][=]", "[-][=]", "[*][=]", "[/][=]", "[=][=]", "[!][=]",
+          "[<][=]", "[>][=]", "[&][&]", "[|][|]", "[<][<]", "[>][>]", "[-][>]",
+          "[+]", "[-]", "[*]", "[/]", "[%]", "[=]", "[<]", "[>]", "[!]", "[&]", "[|]", "[~]", "[\\^]",
+          "[;]", "[,]", "[.]", "\\(", "\\)", "[{]", "[}]", "\\[", "\\]",
+  };
+  for (int i = 0; i < extraTokens; i++) {
+    regexes.push_back("ext" + std::to_string(i) + "[_][a-f]+[0-9]*");
+  }
+  return regexes;
+}
+
+int main(int argc, char *argv[]) {
+  int extraTokens = argc > 1 ? std::stoi(argv[1]) : 100;
+  int repeats = argc > 2 ? std::stoi(argv[2]) : 3;
+  auto regexes = makeSpecRegexes(extraTokens);
+
+  RegexParser parser;
+  std::vector<std::shared_ptr<RegexAST>> asts;
+  std::vector<int> tokenIndices;
+  for (size_t i = 0; i < regexes.size(); i++) {
+    asts.push_back(parser.parse(regexes[i]));
+    tokenIndices.push_back(static_cast<int>(i));
+  }
+
+  using Clock = std::chrono::steady_clock;
+  double bestNfa = 1e100;
+  double bestDfa = 1e100;
+  double bestLazy = 1e100;
+  size_t nfaStates = 0;
+  size_t dfaStates = 0;
+  size_t nfaBytes = 0;
+  for (int r = 0; r < repeats; r++) {
+    ThompsonNFABuilder nfaBuilder;
+    auto t0 = Clock::now();
+    NFA nfa = nfaBuilder.buildCombinedNFA(asts, tokenIndices);
+    auto t1 = Clock::now();
+    SubsetConstructionDFABuilder dfaBuilder;
+    DFA dfa = dfaBuilder.buildFromNFA(nfa);
+    auto t2 = Clock::now();
+    LazyDFA lazy(nfa);
+    auto t3 = Clock::now();
+    bestNfa = std::min(bestNfa, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    bestDfa = std::min(bestDfa, std::chrono::duration<double, std::milli>(t2 - t1).count());
+    bestLazy = std::min(bestLazy, std::chrono::duration<double, std::milli>(t3 - t2).count());
+    nfaStates = nfa.states.size();
+    nfaBytes = nfa.states.size() * sizeof(NFAState)
+               + nfa.edges.size() * sizeof(NFAEdge)
+               + nfa.epsilonTargets.size() * sizeof(int)
+               + (nfa.edgeOffsets.size() + nfa.epsilonOffsets.size()) * sizeof(uint32_t);
+    dfaStates = dfa.states.size();
+  }
+
+  std::cout << "tokens: " << regexes.size()
+            << ", NFA states: " << nfaStates
+            << ", DFA states: " << dfaStates << "\n"
+            << "NFA memory: " << nfaBytes / 1024 << " KB\n"
+            << "NFA build: " << bestNfa << " ms\n"
+            << "DFA build: " << bestDfa << " ms\n"
+            << "LazyDFA setup: " << bestLazy << " ms\n";
+  return 0;
+}
@@ -0,0 +1,180 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../Lexer/Regex/RegexParser.h"
+#include "../../Lexer/NFA/NFABuilder.h"
+#include "../../Lexer/DFA/DFABuiler.h"
+#include "../../Lexer/DFA/DFAMinimizer.h"
+#include "../../Lexer/Reader/TwoBufferReader.h"
+#include "../../Lexer/Reader/MmapReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Lexer/ParallelLexer.h"
+#include "../../Lexer/StringLexer.h"
+#include "../../SymbolTable/SymbolTable.h"
+
+/**
+ * @brief Замер скорости лексера отдельно от парсера: getNextToken(), getNextCompactToken()
+ *        (в том числе с ленивыми позициями и с гарантией линейного времени)
+ *        и tokenizeAll() на синтетическом C-подобном входе, а также StringLexer
+ *        на том же входе, разрезанном на отдельные строки.
+ *
+ * Запуск: DfaLexerBench [lines] [repeats] [threads]
+ *   lines   — сколько строк сгенерировать (по умолчанию 500000);
+ *   repeats — сколько раз повторить каждый замер (по умолчанию 3), печатается лучшее время;
+ *   threads — число потоков для ParallelLexer (по умолчанию все ядра).
+ */
+
+static const std::vector<TokenSpec> SPECS = {
+        {"WHITESPACE", "[ \t\r\n]+", true, 1},
+        {"KEYWORD", "(int|return|while|if)", false, 2},
+        {"OP", "([+]|[-]|[*]|[=]|[<]|[;]|[,]|\\(|\\)|[{]|[}])", false, 3},
+        {"NUMBER", "[0-9]+", false, 4},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 5},
+};
+
+static std::string makeInput(int lines) {
+  std::string text;
+  for (int i = 0; i < lines; i++) {
+    text.append(static_cast<size_t>(i % 4) * 4, ' ');
+    text += "int value_" + std::to_string(i % 1000) + " = compute(x" + std::to_string(i % 37) +
+            ", " + std::to_string(i) + ") * 3;\n";
+  }
+  return text;
+}
+
+int main(int argc, char *argv[]) {
+  int lines = argc > 1 ? std::stoi(argv[1]) : 500000;
+  int repeats = argc > 2 ? std::stoi(argv[2]) : 3;
+  unsigned threads = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : 0;
+
+  RegexParser parser;
+  std::vector<std::shared_ptr<RegexAST>> asts;
+  std::vector<int> tokenIndices;
+  for (size_t i = 0; i < SPECS.size(); i++) {
+    asts.push_back(parser.parse(SPECS[i].regex));
+    tokenIndices.push_back(static_cast<int>(i));
+  }
+  ThompsonNFABuilder nfaBuilder;
+  SubsetConstructionDFABuilder dfaBuilder;
+  DFAMinimizer minimizer;
+  DFA dfa = minimizer.minimize(dfaBuilder.buildFromNFA(nfaBuilder.buildCombinedNFA(asts, tokenIndices)));
+
+  std::string fileName = "dfa_lexer_bench_input.txt";
+  std::string input = makeInput(lines);
+  {
+    std::ofstream ofs(fileName, std::ios::binary);
+    ofs << input;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  auto measure = [&](const char *name, auto &&run) {
+      double best = 1e100;
+      size_t tokens = 0;
+      for (int r = 0; r < repeats; r++) {
+        auto t0 = Clock::now();
+        tokens = run();
+        auto t1 = Clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+      }
+      std::cout << name << ": " << tokens << " tokens, " << best << " ms, "
+                << static_cast<double>(input.size()) / (best * 1000.0) << " MB/s\n";
+  };
+
+  std::cout << "Input: " << input.size() << " bytes, DFA states: " << dfa.states.size() << "\n";
+  for (const char *kind : {"mmap", "buffer"}) {
+    auto makeReader = [&]() -> std::unique_ptr<IReader> {
+        if (std::string(kind) == "mmap") {
+          return std::make_unique<MmapReader>(fileName);
+        }
+        return std::make_unique<TwoBufferReader>(fileName);
+    };
+    std::cout << "[" << kind << "]\n";
+    measure("  getNextToken", [&] {
+        auto reader = makeReader();
+        SymbolTable symbols;
+        DfaLexer lexer(dfa, SPECS, *reader, &symbols);
+        size_t n = 0;
+        while (lexer.getNextToken().type != "END_OF_FILE") {
+          n++;
+        }
+        return n;
+    });
+    measure("  getNextCompactToken", [&] {
+        auto reader = makeReader();
+        SymbolTable symbols;
+        DfaLexer lexer(dfa, SPECS, *reader, &symbols);
+        size_t n = 0;
+        while (lexer.getNextCompactToken().typeId != CompactToken::END_OF_FILE_TYPE) {
+          n++;
+        }
+        return n;
+    });
+    measure("  getNextCompactToken (lazy positions)", [&] {
+        auto reader = makeReader();
+        SymbolTable symbols;
+        DfaLexer lexer(dfa, SPECS, *reader, &symbols);
+        lexer.setLazyPositions(true);
+        size_t n = 0;
+        while (lexer.getNextCompactToken().typeId != CompactToken::END_OF_FILE_TYPE) {
+          n++;
+        }
+        return n;
+    });
+    measure("  getNextCompactToken (linear time)", [&] {
+        auto reader = makeReader();
+        SymbolTable symbols;
+        DfaLexer lexer(dfa, SPECS, *reader, &symbols);
+        lexer.setLinearTime(true);
+        size_t n = 0;
+        while (lexer.getNextCompactToken().typeId != CompactToken::END_OF_FILE_TYPE) {
+          n++;
+        }
+        return n;
+    });
+    // Поток переиспользуется между повторами: clear() сохраняет ёмкость массивов
+    TokenStream stream;
+    measure("  tokenizeAll", [&] {
+        auto reader = makeReader();
+        SymbolTable symbols;
+        DfaLexer lexer(dfa, SPECS, *reader, &symbols);
+        stream.clear();
+        return lexer.tokenizeAll(stream);
+    });
+  }
+  std::cout << "[parallel]\n";
+  TokenStream stream;
+  ParallelLexer parallel(dfa, SPECS, threads);
+  measure("  tokenize", [&] {
+      SymbolTable symbols;
+      stream.clear();
+      return parallel.tokenize(input, stream, &symbols);
+  });
+  std::cout << "  chunks: " << parallel.lastStats().chunks
+            << ", synced: " << parallel.lastStats().syncedChunks
+            << ", relexed tokens: " << parallel.lastStats().relexedTokens << "\n";
+
+  // Много маленьких фрагментов: каждая строка входа разбирается отдельным вызовом
+  std::cout << "[snippets]\n";
+  std::vector<std::string_view> snippets;
+  for (size_t pos = 0; pos < input.size();) {
+    size_t nl = input.find('\n', pos);
+    size_t end = nl == std::string::npos ? input.size() : nl + 1;
+    snippets.emplace_back(input.data() + pos, end - pos);
+    pos = end;
+  }
+  StringLexer stringLexer(dfa, SPECS);
+  measure("  StringLexer::tokenize", [&] {
+      size_t n = 0;
+      for (std::string_view snippet : snippets) {
+        stream.clear();
+        n += stringLexer.tokenize(snippet, stream);
+      }
+      return n;
+  });
+  std::remove(fileName.c_str());
+  return 0;
+}
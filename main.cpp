@@ -4,54 +4,136 @@
 #include <algorithm>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <filesystem>
+#include <unistd.h>
 #include "Preprocessor/GccPreprocessor.h"
 #include "Lexer/TokenSpecification/TokenSpecReader.h"
-#include "Lexer/Regex/RegexAST.h"
-#include "Lexer/Regex/RegexParser.h"
-#include "Lexer/NFA/NFABuilder.h"
-#include "Lexer/DFA/DFABuiler.h"
+#include "Lexer/DFA/LexerDFABuilder.h"
+#include "Lexer/DFA/DFACache.h"
 #include "Lexer/Reader/TwoBufferReader.h"
+#include "Lexer/Reader/MmapReader.h"
+#include "Lexer/Reader/PipeReader.h"
+#include "Lexer/Reader/StringViewReader.h"
 #include "Lexer/DfaLexer.h"
+#include "Lexer/ParallelLexer.h"
 #include "SymbolTable/SymbolTable.h"
 
 
+/**
+ * @brief Записывает текст во временный файл с уникальным именем (mkstemp в системном
+ *        каталоге временных файлов) и возвращает его путь.
+ */
 static std::string writeTempFile(const std::string &content)
 {
-  std::string tempFile = "temp_preprocessed.txt";
-  std::ofstream ofs(tempFile);
-  if (!ofs) {
+  std::string tempFile = (std::filesystem::temp_directory_path() / "analyzer_preprocessed_XXXXXX").string();
+  int fd = mkstemp(tempFile.data());
+  if (fd == -1) {
     throw std::runtime_error("Failed to create temp file: " + tempFile);
   }
+  close(fd);
+  std::ofstream ofs(tempFile, std::ios::binary | std::ios::trunc);
   ofs << content;
   ofs.close();
+  if (!ofs) {
+    std::remove(tempFile.c_str());
+    throw std::runtime_error("Failed to write temp file: " + tempFile);
+  }
   return tempFile;
 }
 
+/**
+ * @brief Удаляет временный файл при выходе из main, в том числе по ошибке.
+ */
+struct TempFileGuard {
+    std::string path;
+
+    ~TempFileGuard() {
+      if (!path.empty() && std::remove(path.c_str()) != 0) {
+        std::cerr << "Failed to remove temp file: " << path << std::endl;
+      }
+    }
+};
+
 int main(int argc, char *argv[])
 {
   if (argc < 3) {
-    std::cerr << "Usage: " << argv[0] << " <token_specs.txt> <input_file>\n";
+    std::cerr << "Usage: " << argv[0]
+              << " <token_specs.txt> <input_file> [--reader=pipe|memory|buffer|mmap] [--dfa-cache=<dir>]"
+              << " [--lex-threads=N] [--linear-time]\n";
     return 1;
   }
   std::string specsFile = argv[1];
   std::string inputFile = argv[2];
+  std::string readerKind = "pipe";
+  std::string cacheDir;
+  unsigned lexThreads = 1;
+  bool linearTime = false;
+  for (int i = 3; i < argc; i++) {
+    std::string opt = argv[i];
+    const std::string readerPrefix = "--reader=";
+    const std::string cachePrefix = "--dfa-cache=";
+    const std::string threadsPrefix = "--lex-threads=";
+    if (opt.rfind(readerPrefix, 0) == 0) {
+      readerKind = opt.substr(readerPrefix.size());
+      if (readerKind != "pipe" && readerKind != "memory" && readerKind != "buffer" && readerKind != "mmap") {
+        std::cerr << "Unknown reader: " << readerKind << std::endl;
+        return 1;
+      }
+    } else if (opt.rfind(cachePrefix, 0) == 0) {
+      cacheDir = opt.substr(cachePrefix.size());
+    } else if (opt.rfind(threadsPrefix, 0) == 0) {
+      try {
+        lexThreads = static_cast<unsigned>(std::stoul(opt.substr(threadsPrefix.size())));
+      } catch (const std::exception &) {
+        std::cerr << "Invalid thread count: " << opt << std::endl;
+        return 1;
+      }
+    } else if (opt == "--linear-time") {
+      linearTime = true;
+    } else {
+      std::cerr << "Unknown option: " << opt << std::endl;
+      return 1;
+    }
+  }
+  if (linearTime && lexThreads != 1) {
+    std::cerr << "--linear-time is not supported with --lex-threads" << std::endl;
+    return 1;
+  }
 
+  // По умолчанию вывод gcc разбирается прямо из канала, пока gcc ещё работает (и пока
+  // строится DFA); --reader=memory|buffer|mmap и --lex-threads собирают его целиком
+  const bool streaming = readerKind == "pipe" && lexThreads == 1;
   GccPreprocessor preprocessor;
+  std::unique_ptr<PreprocessorStream> preprocessorStream;
   std::string preprocessed;
-  try {
-    preprocessed = preprocessor.preprocessFile(inputFile);
-  } catch (const std::exception &e) {
-    std::cerr << "Preprocessor error: " << e.what() << std::endl;
-    return 1;
-  }
+  TempFileGuard tempFile;
+  if (streaming) {
+    try {
+      preprocessorStream = preprocessor.openStream(inputFile);
+    } catch (const std::exception &e) {
+      std::cerr << "Preprocessor error: " << e.what() << std::endl;
+      return 1;
+    }
+  } else {
+    try {
+      preprocessed = preprocessor.preprocessFile(inputFile);
+    } catch (const std::exception &e) {
+      std::cerr << "Preprocessor error: " << e.what() << std::endl;
+      return 1;
+    }
 
-  std::string tempFile;
-  try {
-    tempFile = writeTempFile(preprocessed);
-  } catch (const std::exception &e) {
-    std::cerr << "Write temp file error: " << e.what() << std::endl;
-    return 1;
+    // memory и ParallelLexer разбирают preprocessed прямо в памяти; временный файл нужен
+    // только ридерам, которые читают файл (buffer, mmap)
+    if (lexThreads == 1 && readerKind != "memory") {
+      try {
+        tempFile.path = writeTempFile(preprocessed);
+      } catch (const std::exception &e) {
+        std::cerr << "Write temp file error: " << e.what() << std::endl;
+        return 1;
+      }
+    }
   }
 
   TokenSpecReader tsReader;
@@ -63,47 +145,73 @@ int main(int argc, char *argv[])
     return 1;
   }
 
-  std::sort(specs.begin(), specs.end(), [](const TokenSpec &a, const TokenSpec &b){
-      return a.priority < b.priority;
-  });
-
-  std::vector<std::shared_ptr<RegexAST>> asts;
-  asts.reserve(specs.size());
-  std::vector<int> tokenIndices(specs.size());
+  sortTokenSpecsByPriority(specs);
 
-  try {
-    RegexParser parser;
-    for (size_t i = 0; i < specs.size(); i++) {
-      auto ast = parser.parse(specs[i].regex);
-      asts.push_back(ast);
-      tokenIndices[i] = (int)i;
+  // С --dfa-cache автомат берётся из кэша, если спецификации не менялись
+  DFA dfa;
+  std::optional<DFACache> cache;
+  std::optional<DFA> cached;
+  if (!cacheDir.empty()) {
+    cache.emplace(cacheDir);
+    cached = cache->load(specs);
+  }
+  if (cached) {
+    dfa = std::move(*cached);
+    std::cerr << "DFA loaded from cache: " << cache->pathFor(specs) << "\n";
+  } else {
+    try {
+      LexerDFABuilder dfaBuilder;
+      dfa = dfaBuilder.build(specs);
+      std::cerr << "DFA states: " << dfaBuilder.lastStats().statesBefore
+                << " -> " << dfaBuilder.lastStats().statesAfter << " after minimization\n";
+    } catch (const std::exception &e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    if (cache) {
+      try {
+        cache->store(specs, dfa);
+      } catch (const std::exception &e) {
+        std::cerr << "DFA cache error: " << e.what() << std::endl;
+      }
     }
-  } catch (const std::exception &e) {
-    std::cerr << "Regex parse error: " << e.what() << std::endl;
-    return 1;
   }
 
-  ThompsonNFABuilder nfaBuilder;
-  NFA combinedNFA;
-  try {
-    combinedNFA = nfaBuilder.buildCombinedNFA(asts, tokenIndices);
-  } catch (const std::exception &e) {
-    std::cerr << "Error building combined NFA: " << e.what() << std::endl;
-    return 1;
+  // С --lex-threads=N (N != 1) вход, уже лежащий в памяти, делится на куски по потокам;
+  // --lex-threads=0 — по числу ядер
+  if (lexThreads != 1) {
+    SymbolTable symTable;
+    TokenStream stream;
+    ParallelLexer lexer(dfa, specs, lexThreads);
+    lexer.tokenize(preprocessed, stream, &symTable);
+    for (size_t i = 0; i < stream.size(); i++) {
+      uint16_t typeId = stream.typeIds[i];
+      std::cout << "Type: " << (typeId < specs.size() ? specs[typeId].name : std::string("UNKNOWN"))
+                << ", Lexeme: '" << stream.lexeme(i)
+                << "', Line: " << stream.lines[i]
+                << ", Col: " << stream.columns[i] << "\n";
+    }
+    return 0;
   }
 
-  SubsetConstructionDFABuilder dfaBuilder;
-  DFA dfa;
+  std::unique_ptr<IReader> reader;
   try {
-    dfa = dfaBuilder.buildFromNFA(combinedNFA);
+    if (streaming) {
+      reader = std::make_unique<PipeReader>(preprocessorStream->fd());
+    } else if (readerKind == "memory") {
+      reader = std::make_unique<StringViewReader>(preprocessed);
+    } else if (readerKind == "mmap") {
+      reader = std::make_unique<MmapReader>(tempFile.path);
+    } else {
+      reader = std::make_unique<TwoBufferReader>(tempFile.path);
+    }
   } catch (const std::exception &e) {
-    std::cerr << "Error building DFA: " << e.what() << std::endl;
+    std::cerr << "Reader error: " << e.what() << std::endl;
     return 1;
   }
-
-  TwoBufferReader reader(tempFile);
   SymbolTable symTable;
-  DfaLexer lexer(dfa, specs, reader, &symTable);
+  DfaLexer lexer(dfa, specs, *reader, &symTable);
+  lexer.setLinearTime(linearTime);
 
   while (true) {
     Token tok = lexer.getNextToken();
@@ -115,8 +223,15 @@ int main(int argc, char *argv[])
               << ", Col: " << tok.column << "\n";
   }
 
-  if(std::remove(tempFile.c_str()) != 0) {
-    std::cerr << "Failed to remove temp file: " << tempFile << std::endl;
+  reader.reset();
+  if (streaming) {
+    // Ошибка gcc при потоковом разборе становится известна только после конца вывода
+    try {
+      preprocessorStream->finish();
+    } catch (const std::exception &e) {
+      std::cerr << "Preprocessor error: " << e.what() << std::endl;
+      return 1;
+    }
   }
   return 0;
 }
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "../../Driver/BatchAnalyzer.h"
+#include "../../Lexer/Reader/MmapReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Parser/Table/LR1TableBuilder.h"
+#include "../../SymbolTable/SymbolTable.h"
+#include "../Lexer/TestDFA.h"
+
+namespace fs = std::filesystem;
+
+static const std::vector<TokenSpec> SPECS = {
+        {"WHITESPACE", "[ \t\r\n]+", true, 1},
+        {"PLUS", "[+]", false, 2},
+        {"NUMBER", "[0-9]+", false, 3},
+        {"IDENT", "[a-z]+", false, 4},
+};
+
+/**
+ * @brief Каталог с файлами разного размера; удаляется в деструкторе.
+ */
+class TempTree {
+public:
+    explicit TempTree(const std::string &name) : m_root(fs::temp_directory_path() / name) {
+      fs::remove_all(m_root);
+      fs::create_directories(m_root / "sub");
+    }
+    ~TempTree() { fs::remove_all(m_root); }
+
+    std::string write(const std::string &name, const std::string &content) {
+      fs::path path = m_root / name;
+      std::ofstream ofs(path, std::ios::binary);
+      ofs << content;
+      return path.string();
+    }
+
+    [[nodiscard]] std::string root() const { return m_root.string(); }
+
+private:
+    fs::path m_root;
+};
+
+static std::string makeSum(int terms) {
+  std::string text = "a";
+  for (int i = 0; i < terms; i++) {
+    text += i % 3 == 0 ? " + b\n" : " + " + std::to_string(i);
+  }
+  return text + "\n";
+}
+
+TEST(BatchAnalyzerTest, ReportsInFileOrderForAnyJobCount) {
+  DFA dfa = buildDFA(SPECS);
+  TempTree tree("batch_analyzer_order");
+  std::vector<std::string> files;
+  for (int i = 0; i < 40; i++) {
+    // Размеры сильно различаются, чтобы потоки завершали файлы не по порядку
+    files.push_back(tree.write("f" + std::to_string(i) + ".txt", makeSum((i * 37) % 11 * 500)));
+  }
+  files.push_back(tree.write("bad.txt", "a + ? + b"));
+  files.push_back(tree.root() + "/missing.txt");
+
+  std::vector<FileReport> reference;
+  for (unsigned jobs : {1u, 2u, 8u}) {
+    BatchAnalyzer analyzer(dfa, SPECS, {jobs, true});
+    std::vector<FileReport> reports;
+    analyzer.run(files, [&](const FileReport &r) { reports.push_back(r); });
+    ASSERT_EQ(reports.size(), files.size());
+    for (size_t i = 0; i < files.size(); i++) {
+      EXPECT_EQ(reports[i].path, files[i]);
+    }
+    if (reference.empty()) {
+      reference = reports;
+      continue;
+    }
+    for (size_t i = 0; i < files.size(); i++) {
+      EXPECT_EQ(reports[i].tokens, reference[i].tokens) << i;
+      EXPECT_EQ(reports[i].symbols, reference[i].symbols) << i;
+      EXPECT_EQ(reports[i].tokenDump, reference[i].tokenDump) << i;
+      EXPECT_EQ(reports[i].error, reference[i].error) << i;
+    }
+  }
+
+  // Счётчики совпадают с последовательным DfaLexer
+  for (size_t i = 0; i + 2 < files.size(); i++) {
+    MmapReader reader(files[i]);
+    SymbolTable symbols;
+    DfaLexer lexer(dfa, SPECS, reader, &symbols);
+    size_t tokens = 0;
+    while (lexer.getNextCompactToken().typeId != CompactToken::END_OF_FILE_TYPE) {
+      tokens++;
+    }
+    EXPECT_EQ(reference[i].tokens, tokens) << i;
+    EXPECT_TRUE(reference[i].error.empty());
+  }
+  EXPECT_EQ(reference[files.size() - 2].unknownTokens, 1u);
+  EXPECT_EQ(reference[files.size() - 2].symbols, 2u);
+  EXPECT_FALSE(reference[files.size() - 1].error.empty());
+}
+
+TEST(BatchAnalyzerTest, SlowEmitStaysSerializedAndOrdered) {
+  DFA dfa = buildDFA(SPECS);
+  TempTree tree("batch_analyzer_slow_emit");
+  std::vector<std::string> files;
+  for (int i = 0; i < 30; i++) {
+    files.push_back(tree.write("f" + std::to_string(i) + ".txt", makeSum((i * 7) % 5 * 200)));
+  }
+
+  // emit выполняется вне блокировки: пока он спит, остальные потоки сдают отчёты
+  BatchAnalyzer analyzer(dfa, SPECS, {4, false});
+  std::atomic<int> active{0};
+  int maxActive = 0;
+  std::vector<std::string> paths;
+  analyzer.run(files, [&](const FileReport &r) {
+      int now = ++active;
+      maxActive = std::max(maxActive, now);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      paths.push_back(r.path);
+      --active;
+  });
+  EXPECT_EQ(maxActive, 1);
+  EXPECT_EQ(paths, files);
+}
+
+TEST(BatchAnalyzerTest, ParsesWithSharedTable) {
+  DFA dfa = buildDFA(SPECS);
+  // E : E PLUS T | T ;  T : IDENT | NUMBER
+  Grammar grammar;
+  grammar.terminals = {"PLUS", "IDENT", "NUMBER", "$"};
+  grammar.nonterminals = {"E", "T"};
+  grammar.startSymbol = "E";
+  grammar.productions = {
+          {"E", {"E", "PLUS", "T"}},
+          {"E", {"T"}},
+          {"T", {"IDENT"}},
+          {"T", {"NUMBER"}},
+  };
+  LR1TableBuilder builder;
+  LRTable table = builder.build(grammar);
+
+  TempTree tree("batch_analyzer_parse");
+  std::vector<std::string> files;
+  for (int i = 0; i < 20; i++) {
+    files.push_back(tree.write("ok" + std::to_string(i) + ".txt", makeSum(i * 50)));
+  }
+  files.push_back(tree.write("broken.txt", "a + + b"));
+
+  BatchAnalyzer analyzer(dfa, SPECS, {4, false}, &grammar, &table);
+  std::vector<FileReport> reports;
+  analyzer.run(files, [&](const FileReport &r) { reports.push_back(r); });
+  ASSERT_EQ(reports.size(), files.size());
+  for (size_t i = 0; i + 1 < files.size(); i++) {
+    EXPECT_TRUE(reports[i].parsed) << reports[i].error;
+    EXPECT_TRUE(reports[i].tokenDump.empty());
+  }
+  EXPECT_FALSE(reports.back().parsed);
+  EXPECT_FALSE(reports.back().error.empty());
+}
+
+TEST(BatchAnalyzerTest, CollectsInputs) {
+  TempTree tree("batch_analyzer_inputs");
+  std::string b = tree.write("b.txt", "x");
+  std::string a = tree.write("sub/a.txt", "y");
+  std::string c = tree.write("c.txt", "z");
+  std::string list = tree.write("list.lst", c + "\n\n" + a + "\r\n");
+
+  std::vector<std::string> fromList = BatchAnalyzer::collectInputs({"@" + list});
+  EXPECT_EQ(fromList, (std::vector<std::string>{c, a}));
+
+  std::vector<std::string> fromDir = BatchAnalyzer::collectInputs({tree.root(), b});
+  std::vector<std::string> expected = {b, c, tree.root() + "/list.lst", a, b};
+  EXPECT_EQ(fromDir, expected);
+
+  EXPECT_THROW(BatchAnalyzer::collectInputs({"@" + tree.root() + "/none.lst"}), std::runtime_error);
+}
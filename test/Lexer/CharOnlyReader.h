@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <utility>
+#include "../../Lexer/Reader/IReader.h"
+
+/**
+ * @brief Ридер поверх строки, реализующий только посимвольные методы IReader
+ *        (window()/advance()/mark()/reset() — реализации по умолчанию, то есть без отката).
+ */
+class CharOnlyReader : public IReader {
+public:
+    explicit CharOnlyReader(std::string text) : m_text(std::move(text)) {}
+
+    char getChar() override {
+      if (m_pos >= m_text.size()) {
+        m_eof = true;
+        return '\0';
+      }
+      char c = m_text[m_pos++];
+      if (c == '\n') {
+        m_line++;
+        m_column = 1;
+      } else {
+        m_column++;
+      }
+      return c;
+    }
+    char peekChar(int offset) override {
+      size_t pos = m_pos + static_cast<size_t>(offset);
+      if (pos >= m_text.size()) {
+        if (offset == 0) m_eof = true;
+        return '\0';
+      }
+      return m_text[pos];
+    }
+    [[nodiscard]] bool isEOF() const override { return m_eof; }
+    [[nodiscard]] int getLine() const override { return m_line; }
+    [[nodiscard]] int getColumn() const override { return m_column; }
+    [[nodiscard]] uint64_t getOffset() const override { return m_pos; }
+
+private:
+    std::string m_text;
+    size_t m_pos = 0;
+    bool m_eof = false;
+    int m_line = 1;
+    int m_column = 1;
+};
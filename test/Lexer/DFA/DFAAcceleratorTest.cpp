@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "../../../Lexer/DFA/DFA.h"
+#include "../../../Lexer/DFA/DFAAccelerator.h"
+#include "../../../Lexer/DFA/LazyDFA.h"
+#include "../../../Lexer/TokenSpecification/TokenSpec.h"
+#include "../../../Lexer/Reader/TwoBufferReader.h"
+#include "../../../Lexer/Reader/MmapReader.h"
+#include "../../../Lexer/DfaLexer.h"
+#include "../../../Lexer/LazyDfaLexer.h"
+#include "../TestDFA.h"
+
+static std::array<bool, 256> byteSet(const std::string &members) {
+  std::array<bool, 256> set{};
+  for (unsigned char c : members) {
+    set[c] = true;
+  }
+  return set;
+}
+
+static std::array<bool, 256> allExcept(const std::string &exits) {
+  std::array<bool, 256> set;
+  set.fill(true);
+  for (unsigned char c : exits) {
+    set[c] = false;
+  }
+  return set;
+}
+
+// Пробелы вне блочного комментария и его тело (без '*' и '/')
+static const std::vector<TokenSpec> COMMENT_SPECS = {
+        {"WHITESPACE", "[ \t\r\n]+", true, 1},
+        {"COMMENT", "[/][*]([ -)+-~\t\r\n]|[*]+[ -)+-.0-~\t\r\n])*[*]+[/]", true, 2},
+        {"SLASH", "[/]", false, 3},
+        {"STAR", "[*]", false, 4},
+        {"NUMBER", "[0-9]+", false, 5},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 6},
+};
+
+TEST(ByteSetScannerTest, AllLevelsAgreeWithTable) {
+  std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+  SimdLevel best = detectSimdLevel();
+  if (best != SimdLevel::Scalar) {
+    levels.push_back(SimdLevel::SSE2);
+  }
+  if (best == SimdLevel::AVX2) {
+    levels.push_back(SimdLevel::AVX2);
+  }
+  std::array<bool, 256> everyOther{};
+  for (int c = 0; c < 256; c += 2) {
+    everyOther[c] = true;
+  }
+  std::vector<std::array<bool, 256>> sets = {
+          byteSet(" \t\r\n"),                       // диапазоны
+          byteSet("abcdefghijklmnopqrstuvwxyz_0123456789"),
+          allExcept("*"),                           // memchr
+          allExcept("\"\\\n"),                      // три выхода
+          everyOther,                               // таблица
+          allExcept(""),
+  };
+  std::mt19937 rng(42);
+  std::string alphabet = " \t\r\n*\"\\abcxyz_019\x80\xff";
+  for (const auto &set : sets) {
+    for (int round = 0; round < 200; round++) {
+      // Длинные серии из множества с редкими «чужими» байтами на разных позициях
+      size_t len = rng() % 150;
+      std::string text;
+      for (size_t i = 0; i < len; i++) {
+        char c = alphabet[rng() % alphabet.size()];
+        text += (rng() % 20 == 0 || set[static_cast<unsigned char>(c)]) ? c : ' ';
+      }
+      size_t expected = 0;
+      while (expected < text.size() && set[static_cast<unsigned char>(text[expected])]) {
+        expected++;
+      }
+      for (SimdLevel level : levels) {
+        ByteSetScanner scanner(set, level);
+        EXPECT_EQ(scanner.span(text.data(), text.size()), expected);
+      }
+    }
+  }
+}
+
+TEST(DFAAcceleratorTest, FindsWhitespaceSkipState) {
+  std::vector<TokenSpec> specs = {
+          {"WHITESPACE", "[ \t\r\n]+", true, 1},
+          {"IDENT", "[a-zA-Z]+", false, 2},
+  };
+  DFA dfa = buildDFA(specs);
+  DFAAccelerator accel(dfa, specs);
+  int ws = accel.skipState(' ');
+  ASSERT_NE(ws, -1);
+  EXPECT_EQ(accel.skipState('\n'), ws);
+  EXPECT_EQ(accel.skipState('a'), -1);
+  EXPECT_TRUE(accel.stateFlags()[ws] & DFAAccelerator::LOOP);
+  EXPECT_TRUE(accel.loopScanner(ws).contains('\t'));
+  // Петля идентификатора — принимающее неигнорируемое состояние, её не ускоряем
+  int ident = dfa.next(dfa.startState, 'a');
+  EXPECT_FALSE(accel.stateFlags()[ident] & DFAAccelerator::LOOP);
+  EXPECT_TRUE(accel.stateFlags()[ident] & DFAAccelerator::ACCEPT);
+}
+
+TEST(DFAAcceleratorTest, AcceleratesCommentBody) {
+  DFA dfa = buildDFA(COMMENT_SPECS);
+  DFAAccelerator accel(dfa, COMMENT_SPECS);
+  int slash = dfa.next(dfa.startState, '/');
+  ASSERT_NE(slash, -1);
+  int body = dfa.next(slash, '*');
+  ASSERT_NE(body, -1);
+  EXPECT_TRUE(accel.stateFlags()[body] & DFAAccelerator::LOOP);
+  EXPECT_FALSE(accel.loopScanner(body).contains('*'));
+  EXPECT_EQ(accel.skipState('/'), -1);
+}
+
+TEST(DFAAcceleratorTest, LexerOutputUnchanged) {
+  DFA dfa = buildDFA(COMMENT_SPECS);
+  NFA nfa = buildNFA(COMMENT_SPECS);
+  LazyDFA lazy(nfa);
+
+  std::string testInput;
+  for (int i = 0; i < 300; i++) {
+    testInput += "x" + std::to_string(i) + std::string(static_cast<size_t>(i % 70), ' ') + "\t\n";
+    testInput += "/* comment " + std::to_string(i) + " ** with / stars */";
+    testInput += std::string(static_cast<size_t>(i % 40), '\n') + "a/b*c /**/ 7 ";
+  }
+  testInput += "/* unterminated";
+  std::string fileName = "tmp_accel_lexer.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  auto collect = [](auto &lexer) {
+      std::vector<Token> tokens;
+      while (true) {
+        Token t = lexer.getNextToken();
+        tokens.push_back(t);
+        if (t.type == "END_OF_FILE") break;
+      }
+      return tokens;
+  };
+  TwoBufferReader lazyReader(fileName, 64);
+  LazyDfaLexer reference(lazy, COMMENT_SPECS, lazyReader, nullptr);
+  auto expected = collect(reference);
+
+  TwoBufferReader bufferReader(fileName, 16);
+  DfaLexer bufferLexer(dfa, COMMENT_SPECS, bufferReader, nullptr);
+  MmapReader mmapReader(fileName);
+  DfaLexer mmapLexer(dfa, COMMENT_SPECS, mmapReader, nullptr);
+  auto fromBuffer = collect(bufferLexer);
+  auto fromMmap = collect(mmapLexer);
+
+  ASSERT_EQ(fromBuffer.size(), expected.size());
+  ASSERT_EQ(fromMmap.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(fromBuffer[i].type, expected[i].type) << i;
+    EXPECT_EQ(fromBuffer[i].lexeme, expected[i].lexeme) << i;
+    EXPECT_EQ(fromBuffer[i].line, expected[i].line) << i;
+    EXPECT_EQ(fromBuffer[i].column, expected[i].column) << i;
+    EXPECT_EQ(fromMmap[i].type, expected[i].type) << i;
+    EXPECT_EQ(fromMmap[i].lexeme, expected[i].lexeme) << i;
+    EXPECT_EQ(fromMmap[i].line, expected[i].line) << i;
+    EXPECT_EQ(fromMmap[i].column, expected[i].column) << i;
+  }
+  std::remove(fileName.c_str());
+}
@@ -3,7 +3,31 @@
 #include "../../../Lexer/NFA/NFA.h"
 #include "../../../Lexer/DFA/DFABuiler.h"
 #include "../../../Lexer/NFA/NFABuilder.h"
+#include "../../../Lexer/Regex/RegexParser.h"
 
+/**
+ * @brief Строит DFA для одного регулярного выражения (токен 0).
+ */
+static DFA buildSingle(const std::string &regex) {
+  RegexParser parser;
+  ThompsonNFABuilder nfaBuilder;
+  SubsetConstructionDFABuilder dfaBuilder;
+  return dfaBuilder.buildFromNFA(nfaBuilder.buildCombinedNFA({parser.parse(regex)}, {0}));
+}
+
+/**
+ * @brief Токен, которым DFA допускает строку s целиком, или -1.
+ */
+static int acceptedToken(const DFA &dfa, const std::string &s) {
+  int state = dfa.startState;
+  for (char c : s) {
+    state = dfa.next(state, (unsigned char)c);
+    if (state < 0) {
+      return -1;
+    }
+  }
+  return dfa.states[state].isAccept ? dfa.states[state].tokenIndex : -1;
+}
 
 TEST(DFABuilderTest, EmptyNFA) {
   SubsetConstructionDFABuilder dfaBuilder;
@@ -28,11 +52,11 @@ TEST(DFABuilderTest, SingleLiteralNFA) {
 
   unsigned char c = (unsigned char)('a');
 
-  EXPECT_EQ(dfa.states[0].transitions[c], 1);
+  EXPECT_EQ(dfa.next(0, c), 1);
 
   for (int sym = 0; sym < 256; sym++) {
     if (sym != c) {
-      EXPECT_EQ(dfa.states[0].transitions[sym], -1);
+      EXPECT_EQ(dfa.next(0, (unsigned char)sym), -1);
     }
   }
 
@@ -54,8 +78,8 @@ TEST(DFABuilderTest, CombinedSimple) {
 
   ASSERT_LE(dfa.states.size(), 3u);
 
-  int aState = dfa.states[0].transitions[(unsigned char)'a'];
-  int bState = dfa.states[0].transitions[(unsigned char)'b'];
+  int aState = dfa.next(0, (unsigned char)'a');
+  int bState = dfa.next(0, (unsigned char)'b');
 
   ASSERT_NE(aState, -1);
   ASSERT_NE(bState, -1);
@@ -64,3 +88,92 @@ TEST(DFABuilderTest, CombinedSimple) {
   EXPECT_TRUE(dfa.states[bState].isAccept);
   EXPECT_EQ(dfa.states[bState].tokenIndex, 20);
 }
+
+TEST(DFABuilderTest, ByteClasses) {
+  ThompsonNFABuilder nfaBuilder;
+  RegexParser parser;
+  std::vector<std::shared_ptr<RegexAST>> asts = {parser.parse("[a-z]+"), parser.parse("[0-9]+")};
+  std::vector<int> tokens = {0, 1};
+  NFA combinedNFA = nfaBuilder.buildCombinedNFA(asts, tokens);
+
+  SubsetConstructionDFABuilder dfaBuilder;
+  DFA dfa = dfaBuilder.buildFromNFA(combinedNFA);
+
+  // Классы: [a-z], [0-9] и все остальные байты
+  EXPECT_EQ(dfa.classCount, 3);
+  EXPECT_EQ(dfa.transitions.size(), dfa.states.size() * dfa.classCount);
+  EXPECT_NE(dfa.classOf[(unsigned char)'a'], dfa.classOf[(unsigned char)'0']);
+  EXPECT_EQ(dfa.classOf[(unsigned char)' '], dfa.classOf[(unsigned char)'A']);
+  EXPECT_EQ(dfa.classOf[(unsigned char)'~'], dfa.classOf[(unsigned char)'A']);
+
+  int word = dfa.next(dfa.startState, 'x');
+  ASSERT_NE(word, -1);
+  EXPECT_EQ(dfa.states[word].tokenIndex, 0);
+  int word2 = dfa.next(word, 'y');
+  ASSERT_NE(word2, -1);
+  EXPECT_EQ(dfa.states[word2].tokenIndex, 0);
+  EXPECT_EQ(dfa.next(word, '1'), -1);
+  int number = dfa.next(dfa.startState, '7');
+  ASSERT_NE(number, -1);
+  EXPECT_EQ(dfa.states[number].tokenIndex, 1);
+  EXPECT_EQ(dfa.next(dfa.startState, ' '), -1);
+}
+
+// Эпсилон-циклы: замыкания считаются по конденсации компонент сильной связности,
+// и состояния одной компоненты должны получить одно и то же замыкание
+
+TEST(DFABuilderTest, EpsilonCycleOptionalStar) {
+  DFA dfa = buildSingle("(a?)*");
+  for (const char *s : {"", "a", "aa", "aaaaa"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), 0) << s;
+  }
+  for (const char *s : {"b", "ab", "aab"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), -1) << s;
+  }
+}
+
+TEST(DFABuilderTest, EpsilonCycleNestedStars) {
+  DFA dfa = buildSingle("(a*)*b");
+  for (const char *s : {"b", "ab", "aaab"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), 0) << s;
+  }
+  for (const char *s : {"", "a", "aa", "ba", "bb", "abb"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), -1) << s;
+  }
+}
+
+TEST(DFABuilderTest, EpsilonCyclePlusOverOptional) {
+  DFA dfa = buildSingle("(a|b?)+");
+  for (const char *s : {"", "a", "b", "abba", "bbbb"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), 0) << s;
+  }
+  for (const char *s : {"c", "abc", "ca"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), -1) << s;
+  }
+}
+
+TEST(DFABuilderTest, NestedEpsilonComponents) {
+  // Компонента (b?)* вложена в компоненту внешней звёздочки, за которой идёт обязательный c
+  DFA dfa = buildSingle("((a*)*|(b?)*)*c(d?)*");
+  for (const char *s : {"c", "ac", "bc", "abbac", "cd", "aacddd"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), 0) << s;
+  }
+  for (const char *s : {"", "a", "ab", "cc", "dc", "cda"}) {
+    EXPECT_EQ(acceptedToken(dfa, s), -1) << s;
+  }
+}
+
+TEST(DFABuilderTest, EpsilonCyclesInCombinedNFA) {
+  // Две спецификации с эпсилон-циклами: при совпадении побеждает меньший индекс
+  RegexParser parser;
+  ThompsonNFABuilder nfaBuilder;
+  SubsetConstructionDFABuilder dfaBuilder;
+  DFA dfa = dfaBuilder.buildFromNFA(nfaBuilder.buildCombinedNFA(
+          {parser.parse("(a*)*b"), parser.parse("(a|b?)+")}, {0, 1}));
+  EXPECT_EQ(acceptedToken(dfa, "aab"), 0);
+  EXPECT_EQ(acceptedToken(dfa, "b"), 0);
+  EXPECT_EQ(acceptedToken(dfa, "aa"), 1);
+  EXPECT_EQ(acceptedToken(dfa, "ba"), 1);
+  EXPECT_EQ(acceptedToken(dfa, ""), 1);
+  EXPECT_EQ(acceptedToken(dfa, "c"), -1);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "../../../Lexer/DFA/DFA.h"
+#include "../../../Lexer/DFA/DFAFile.h"
+#include "../../../Lexer/DFA/DFACache.h"
+#include "../TestDFA.h"
+
+static void expectSameDFA(const DFA &a, const DFA &b) {
+  EXPECT_EQ(a.startState, b.startState);
+  EXPECT_EQ(a.classCount, b.classCount);
+  EXPECT_EQ(a.classOf, b.classOf);
+  EXPECT_EQ(a.transitions, b.transitions);
+  ASSERT_EQ(a.states.size(), b.states.size());
+  for (size_t i = 0; i < a.states.size(); i++) {
+    EXPECT_EQ(a.states[i].isAccept, b.states[i].isAccept);
+    EXPECT_EQ(a.states[i].tokenIndex, b.states[i].tokenIndex);
+  }
+}
+
+static const std::vector<TokenSpec> SPECS = {
+        {"IF", "if", false, 20},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+        {"NUMBER", "[0-9]+", false, 9},
+        {"WHITESPACE", "[ \t\r\n]+", true, 1}
+};
+
+TEST(DFAFileTest, RoundTrip) {
+  DFA dfa = buildUnminimizedDFA(SPECS);
+  std::string path = "tmp_dfa_roundtrip.bin";
+  DFAFileWriter().write(path, dfa, SPECS);
+
+  DFAFileLoader loader(path);
+  EXPECT_EQ(loader.header().version, DFA_FILE_VERSION);
+  EXPECT_EQ(loader.specHash(), hashTokenSpecs(SPECS));
+  EXPECT_EQ(loader.transitions().size(), dfa.transitions.size());
+  expectSameDFA(loader.toDFA(), dfa);
+
+  auto specs = loader.tokenSpecs();
+  ASSERT_EQ(specs.size(), SPECS.size());
+  for (size_t i = 0; i < specs.size(); i++) {
+    EXPECT_EQ(specs[i].name, SPECS[i].name);
+    EXPECT_EQ(specs[i].regex, SPECS[i].regex);
+    EXPECT_EQ(specs[i].ignore, SPECS[i].ignore);
+    EXPECT_EQ(specs[i].priority, SPECS[i].priority);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(DFAFileTest, RejectsCorruptFiles) {
+  DFA dfa = buildUnminimizedDFA(SPECS);
+  std::string path = "tmp_dfa_corrupt.bin";
+  DFAFileWriter().write(path, dfa, SPECS);
+  std::string image;
+  {
+    std::ifstream ifs(path, std::ios::binary);
+    image.assign(std::istreambuf_iterator<char>(ifs), {});
+  }
+  auto rewrite = [&](const std::string &bytes) {
+      std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+      ofs.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  };
+
+  std::string badVersion = image;
+  badVersion[offsetof(DFAFileHeader, version)] ^= 0x7f;
+  rewrite(badVersion);
+  EXPECT_THROW(DFAFileLoader{path}, std::runtime_error);
+
+  rewrite(image.substr(0, image.size() - 3));
+  EXPECT_THROW(DFAFileLoader{path}, std::runtime_error);
+
+  std::string badTransition = image;
+  DFAFileHeader header{};
+  std::memcpy(&header, image.data(), sizeof(header));
+  int32_t outOfRange = static_cast<int32_t>(header.stateCount) + 5;
+  std::memcpy(badTransition.data() + header.transitionsOffset, &outOfRange, sizeof(outOfRange));
+  rewrite(badTransition);
+  EXPECT_THROW(DFAFileLoader{path}, std::runtime_error);
+
+  std::remove(path.c_str());
+  EXPECT_THROW(DFAFileLoader{path}, std::runtime_error);
+}
+
+TEST(DFAFileTest, SpecHashDependsOnContentAndOrder) {
+  auto changed = SPECS;
+  changed[2].regex = "[0-9]*";
+  auto reordered = SPECS;
+  std::swap(reordered[0], reordered[1]);
+  EXPECT_EQ(hashTokenSpecs(SPECS), hashTokenSpecs(std::vector<TokenSpec>(SPECS)));
+  EXPECT_NE(hashTokenSpecs(SPECS), hashTokenSpecs(changed));
+  EXPECT_NE(hashTokenSpecs(SPECS), hashTokenSpecs(reordered));
+}
+
+TEST(DFACacheTest, MissStoreHit) {
+  std::string dir = "tmp_dfa_cache_dir";
+  std::filesystem::remove_all(dir);
+  DFACache cache(dir);
+  EXPECT_FALSE(cache.load(SPECS).has_value());
+
+  DFA dfa = buildUnminimizedDFA(SPECS);
+  cache.store(SPECS, dfa);
+  auto loaded = cache.load(SPECS);
+  ASSERT_TRUE(loaded.has_value());
+  expectSameDFA(*loaded, dfa);
+
+  // Другой набор спецификаций — другой ключ
+  auto changed = SPECS;
+  changed[0].regex = "iff";
+  EXPECT_NE(cache.pathFor(changed), cache.pathFor(SPECS));
+  EXPECT_FALSE(cache.load(changed).has_value());
+
+  // Повреждённый файл — промах, а не исключение
+  {
+    std::ofstream ofs(cache.pathFor(SPECS), std::ios::binary | std::ios::trunc);
+    ofs << "garbage";
+  }
+  EXPECT_FALSE(cache.load(SPECS).has_value());
+  std::filesystem::remove_all(dir);
+}
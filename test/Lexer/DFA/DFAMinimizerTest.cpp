@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "../../../Lexer/DFA/DFA.h"
+#include "../../../Lexer/DFA/DFABuiler.h"
+#include "../../../Lexer/DFA/DFAMinimizer.h"
+#include "../TestDFA.h"
+
+/**
+ * @brief Прогоняет автомат по строке и возвращает tokenIndex после каждого символа
+ *        (-1 — непринимающее состояние, -2 — переход отсутствует).
+ */
+static std::vector<int> run(const DFA &dfa, const std::string &input) {
+  std::vector<int> trace;
+  int state = dfa.startState;
+  for (char c : input) {
+    state = dfa.next(state, (unsigned char)c);
+    if (state == -1) {
+      trace.push_back(-2);
+      break;
+    }
+    trace.push_back(dfa.states[state].isAccept ? dfa.states[state].tokenIndex : -1);
+  }
+  return trace;
+}
+
+TEST(DFAMinimizerTest, MergesEquivalentStates) {
+  DFA dfa = buildUnminimizedDFA(specsOf({"[a-z]+", "[0-9]+"}));
+  DFAMinimizer minimizer;
+  DFA minimal = minimizer.minimize(dfa);
+
+  // Старт, «слово», «число»
+  EXPECT_EQ(minimal.states.size(), 3u);
+  EXPECT_EQ(minimal.startState, 0);
+  EXPECT_EQ(minimizer.lastStats().statesBefore, dfa.states.size());
+  EXPECT_EQ(minimizer.lastStats().statesAfter, 3u);
+
+  for (const std::string input : {"abc", "z9", "123", "4a", "", "q-", "?"}) {
+    EXPECT_EQ(run(minimal, input), run(dfa, input)) << input;
+  }
+}
+
+TEST(DFAMinimizerTest, MergesRedundantSubsetStates) {
+  // Подмножества после "a" и после "c" различны, но автомат их не различает
+  DFA dfa = buildUnminimizedDFA(specsOf({"ab|cb"}));
+  DFAMinimizer minimizer;
+  DFA minimal = minimizer.minimize(dfa);
+
+  EXPECT_EQ(minimal.states.size(), 3u);
+  EXPECT_GT(minimizer.lastStats().statesBefore, minimizer.lastStats().statesAfter);
+  EXPECT_EQ(minimal.next(minimal.startState, 'a'), minimal.next(minimal.startState, 'c'));
+  for (const std::string input : {"ab", "cb", "bb", "a", "abb"}) {
+    EXPECT_EQ(run(minimal, input), run(dfa, input)) << input;
+  }
+}
+
+TEST(DFAMinimizerTest, KeepsDifferentTokensApart) {
+  DFA dfa = buildUnminimizedDFA(specsOf({"ab", "cb", "a(b|d)"}));
+  DFAMinimizer minimizer;
+  DFA minimal = minimizer.minimize(dfa);
+
+  int afterA = minimal.next(minimal.startState, 'a');
+  int afterC = minimal.next(minimal.startState, 'c');
+  ASSERT_NE(afterA, -1);
+  ASSERT_NE(afterC, -1);
+  // Из "a" и "c" по 'b' попадаем в принимающие состояния разных токенов
+  EXPECT_NE(afterA, afterC);
+  int ab = minimal.next(afterA, 'b');
+  int cb = minimal.next(afterC, 'b');
+  int ad = minimal.next(afterA, 'd');
+  ASSERT_NE(ab, -1);
+  ASSERT_NE(cb, -1);
+  ASSERT_NE(ad, -1);
+  EXPECT_EQ(minimal.states[ab].tokenIndex, 0);
+  EXPECT_EQ(minimal.states[cb].tokenIndex, 1);
+  EXPECT_EQ(minimal.states[ad].tokenIndex, 2);
+  EXPECT_NE(ab, cb);
+  EXPECT_NE(ab, ad);
+
+  for (const std::string input : {"ab", "cb", "ad", "cd", "abb", "x"}) {
+    EXPECT_EQ(run(minimal, input), run(dfa, input)) << input;
+  }
+}
+
+TEST(DFAMinimizerTest, EmptyDFA) {
+  SubsetConstructionDFABuilder dfaBuilder;
+  DFA dfa = dfaBuilder.buildFromNFA(NFA{});
+  DFAMinimizer minimizer;
+  DFA minimal = minimizer.minimize(dfa);
+
+  ASSERT_EQ(minimal.states.size(), 1u);
+  EXPECT_FALSE(minimal.states[0].isAccept);
+  EXPECT_EQ(minimal.next(0, 'a'), -1);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "../../../Lexer/DFA/DFA.h"
+#include "../../../Lexer/DFA/DFABuiler.h"
+#include "../../../Lexer/DFA/LazyDFA.h"
+#include "../TestDFA.h"
+
+/**
+ * @brief Прогоняет ленивый и полный автоматы по строке и сравнивает состояние после каждого символа.
+ */
+static void expectSameTrace(LazyDFA &lazy, const DFA &dfa, const std::string &input) {
+  int l = lazy.startState();
+  int d = dfa.startState;
+  for (char c : input) {
+    l = lazy.next(l, (unsigned char)c);
+    d = dfa.next(d, (unsigned char)c);
+    ASSERT_EQ(l == -1, d == -1) << input;
+    if (d == -1) {
+      return;
+    }
+    EXPECT_EQ(lazy.state(l).isAccept, dfa.states[d].isAccept) << input;
+    EXPECT_EQ(lazy.state(l).tokenIndex, dfa.states[d].tokenIndex) << input;
+  }
+}
+
+static const std::vector<std::string> REGEXES = {
+        "if", "int", "[a-zA-Z_][a-zA-Z0-9_]*", "[0-9]+", "0[xX][0-9a-f]+", "[ \t\n]+", "[+][+]", "[+]"
+};
+
+static const std::vector<std::string> INPUTS = {
+        "if", "int", "integer", "i", "0x1f", "0xg", "123abc", "++", "+", "   x", "_a1", "", "?", "if+"
+};
+
+TEST(LazyDFATest, MatchesEagerDFA) {
+  NFA nfa = buildNFA(specsOf(REGEXES));
+  DFA dfa = SubsetConstructionDFABuilder().buildFromNFA(nfa);
+  LazyDFA lazy(nfa);
+
+  for (const auto &input : INPUTS) {
+    expectSameTrace(lazy, dfa, input);
+  }
+  EXPECT_EQ(lazy.classCount(), dfa.classCount);
+  // Построены только реально посещённые состояния
+  EXPECT_LE(lazy.cachedStates(), dfa.states.size());
+  EXPECT_EQ(lazy.stats().cacheFlushes, 0u);
+}
+
+TEST(LazyDFATest, BuildsStatesOnDemand) {
+  NFA nfa = buildNFA(specsOf(REGEXES));
+  LazyDFA lazy(nfa);
+  EXPECT_EQ(lazy.cachedStates(), 1u);
+
+  int s = lazy.next(lazy.startState(), 'i');
+  ASSERT_NE(s, -1);
+  size_t afterFirst = lazy.cachedStates();
+  EXPECT_EQ(afterFirst, 2u);
+  // Повторный переход берётся из кэша
+  EXPECT_EQ(lazy.next(lazy.startState(), 'i'), s);
+  EXPECT_EQ(lazy.cachedStates(), afterFirst);
+  EXPECT_EQ(lazy.next(lazy.startState(), '?'), -1);
+}
+
+TEST(LazyDFATest, FlushesWhenOverBudget) {
+  NFA nfa = buildNFA(specsOf(REGEXES));
+  DFA dfa = SubsetConstructionDFABuilder().buildFromNFA(nfa);
+  // Бюджет меньше пустой хэш-таблицы: сброс при каждом новом состоянии
+  LazyDFA lazy(nfa, 1);
+
+  for (int round = 0; round < 3; round++) {
+    for (const auto &input : INPUTS) {
+      expectSameTrace(lazy, dfa, input);
+    }
+  }
+  EXPECT_GT(lazy.stats().cacheFlushes, 0u);
+  EXPECT_LE(lazy.cachedStates(), 3u);
+}
+
+TEST(LazyDFATest, EmptyNFA) {
+  NFA nfa;
+  LazyDFA lazy(nfa);
+  EXPECT_EQ(lazy.cachedStates(), 1u);
+  EXPECT_FALSE(lazy.state(lazy.startState()).isAccept);
+  EXPECT_EQ(lazy.next(lazy.startState(), 'a'), -1);
+}
@@ -1,37 +1,24 @@
 #include <gtest/gtest.h>
 #include <fstream>
+#include <random>
+#include <unistd.h>
 #include "../../Lexer/DFA/DFA.h"
 #include "../../Lexer/TokenSpecification/TokenSpec.h"
-#include "../../Lexer/Regex/RegexAST.h"
-#include "../../Lexer/Regex/RegexParser.h"
-#include "../../Lexer/NFA/NFABuilder.h"
-#include "../../Lexer/DFA/DFABuiler.h"
 #include "../../SymbolTable/SymbolTable.h"
 #include "../../Lexer/Reader/TwoBufferReader.h"
+#include "../../Lexer/Reader/MmapReader.h"
+#include "../../Lexer/Reader/PipeReader.h"
 #include "../../Lexer/DfaLexer.h"
-
-static DFA buildDFAFromSpecs(const std::vector<TokenSpec> &specs) {
-  std::vector<std::shared_ptr<RegexAST>> asts;
-  asts.reserve(specs.size());
-  std::vector<int> tokenIndexes(specs.size());
-  RegexParser parser;
-  ThompsonNFABuilder nfaBuilder;
-  SubsetConstructionDFABuilder dfaBuilder;
-  for (size_t i = 0; i < specs.size(); i++) {
-    auto ast = parser.parse(specs[i].regex);
-    asts.push_back(ast);
-    tokenIndexes[i] = static_cast<int>(i);
-  }
-  NFA combined = nfaBuilder.buildCombinedNFA(asts, tokenIndexes);
-  return dfaBuilder.buildFromNFA(combined);
-}
+#include "../../Lexer/Token/TokenStream.h"
+#include "CharOnlyReader.h"
+#include "TestDFA.h"
 
 TEST(DfaLexerTest, SimpleIdentifiers) {
   std::vector<TokenSpec> specs = {
           {"IDENT", "[a-zA-Z]+", false, 10},
           {"WHITESPACE", "[ \t\r\n]+", true, 1}
   };
-  DFA dfa = buildDFAFromSpecs(specs);
+  DFA dfa = buildUnminimizedDFA(specs);
   std::string testInput = "Hello World   Foo123";
   SymbolTable symTable;
   {
@@ -79,7 +66,7 @@ TEST(DfaLexerTest, IdentAndNumber) {
           {"NUMBER", "[0-9]+", false, 9},
           {"WHITESPACE", "[ \t\r\n]+", true, 1}
   };
-  DFA dfa = buildDFAFromSpecs(specs);
+  DFA dfa = buildUnminimizedDFA(specs);
   std::string testInput = "x1 234 __foo 99bar";
   SymbolTable symTable;
   {
@@ -116,3 +103,409 @@ TEST(DfaLexerTest, IdentAndNumber) {
   }
   std::remove("tmp_lexer_test2.txt");
 }
+
+TEST(DfaLexerTest, ReaderWithoutWindow) {
+  std::vector<TokenSpec> specs = {
+          {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+          {"NUMBER", "[0-9]+", false, 9},
+          {"WHITESPACE", "[ \t\r\n]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  CharOnlyReader reader("x1 234\n  __foo");
+  DfaLexer lexer(dfa, specs, reader, nullptr);
+
+  Token t1 = lexer.getNextToken();
+  EXPECT_EQ(t1.type, "IDENT");
+  EXPECT_EQ(t1.lexeme, "x1");
+
+  Token t2 = lexer.getNextToken();
+  EXPECT_EQ(t2.type, "NUMBER");
+  EXPECT_EQ(t2.lexeme, "234");
+  EXPECT_EQ(t2.column, 4);
+
+  Token t3 = lexer.getNextToken();
+  EXPECT_EQ(t3.type, "IDENT");
+  EXPECT_EQ(t3.lexeme, "__foo");
+  EXPECT_EQ(t3.line, 2);
+  EXPECT_EQ(t3.column, 3);
+
+  Token eof = lexer.getNextToken();
+  EXPECT_EQ(eof.type, "END_OF_FILE");
+}
+
+TEST(DfaLexerTest, WindowedReadersAgree) {
+  std::vector<TokenSpec> specs = {
+          {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+          {"NUMBER", "[0-9]+", false, 9},
+          {"WHITESPACE", "[ \t\r\n]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  std::string testInput;
+  for (int i = 0; i < 200; i++) {
+    testInput += "ident_" + std::to_string(i) + " " + std::to_string(i * 7) + (i % 5 == 0 ? "\n" : "  ");
+  }
+  std::string fileName = "tmp_lexer_windowed.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  auto collect = [&](IReader &reader) {
+      DfaLexer lexer(dfa, specs, reader, nullptr);
+      std::vector<Token> tokens;
+      while (true) {
+        Token t = lexer.getNextToken();
+        if (t.type == "END_OF_FILE") break;
+        tokens.push_back(t);
+      }
+      return tokens;
+  };
+
+  CharOnlyReader charReader(testInput);
+  TwoBufferReader bufferReader(fileName, 5);
+  MmapReader mmapReader(fileName);
+  auto expected = collect(charReader);
+  auto fromBuffer = collect(bufferReader);
+  auto fromMmap = collect(mmapReader);
+
+  ASSERT_EQ(expected.size(), 400u);
+  ASSERT_EQ(fromBuffer.size(), expected.size());
+  ASSERT_EQ(fromMmap.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(fromBuffer[i].type, expected[i].type);
+    EXPECT_EQ(fromBuffer[i].lexeme, expected[i].lexeme);
+    EXPECT_EQ(fromBuffer[i].line, expected[i].line);
+    EXPECT_EQ(fromBuffer[i].column, expected[i].column);
+    EXPECT_EQ(fromMmap[i].lexeme, expected[i].lexeme);
+    EXPECT_EQ(fromMmap[i].line, expected[i].line);
+    EXPECT_EQ(fromMmap[i].column, expected[i].column);
+  }
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, CompactTokens) {
+  std::vector<TokenSpec> specs = {
+          {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+          {"NUMBER", "[0-9]+", false, 9},
+          {"WHITESPACE", "[ \t\r\n]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  std::string testInput = "foo 42\n bar $";
+  std::string fileName = "tmp_lexer_compact.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+  SymbolTable symTable;
+  {
+    MmapReader reader(fileName);
+    DfaLexer lexer(dfa, specs, reader, &symTable);
+
+    CompactToken t1 = lexer.getNextCompactToken();
+    EXPECT_EQ(t1.typeId, 0);
+    EXPECT_EQ(t1.lexeme, "foo");
+    EXPECT_EQ(t1.offset, 0u);
+    EXPECT_EQ(t1.symbolId, 0);
+
+    CompactToken t2 = lexer.getNextCompactToken();
+    EXPECT_EQ(t2.typeId, 1);
+    EXPECT_EQ(t2.lexeme, "42");
+    EXPECT_EQ(t2.offset, 4u);
+    EXPECT_EQ(t2.symbolId, -1);
+
+    CompactToken t3 = lexer.getNextCompactToken();
+    EXPECT_EQ(t3.lexeme, "bar");
+    EXPECT_EQ(t3.offset, 8u);
+    EXPECT_EQ(t3.line, 2);
+    EXPECT_EQ(t3.column, 2);
+    // Лексемы из mmap остаются действительными после следующих вызовов
+    EXPECT_EQ(t1.lexeme, "foo");
+
+    CompactToken t4 = lexer.getNextCompactToken();
+    EXPECT_EQ(t4.typeId, CompactToken::UNKNOWN_TYPE);
+    EXPECT_EQ(t4.lexeme, "$");
+    EXPECT_EQ(t4.offset, 12u);
+
+    CompactToken eof = lexer.getNextCompactToken();
+    EXPECT_EQ(eof.typeId, CompactToken::END_OF_FILE_TYPE);
+
+    Token converted = lexer.toToken(t3);
+    EXPECT_EQ(converted.type, "IDENT");
+    EXPECT_EQ(converted.lexeme, "bar");
+    EXPECT_EQ(converted.line, 2);
+    EXPECT_EQ(converted.symbolId, 1);
+    EXPECT_EQ(lexer.typeName(t4.typeId), "UNKNOWN");
+    EXPECT_EQ(lexer.typeName(eof.typeId), "END_OF_FILE");
+  }
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, TokenizeAllFillsTokenStream) {
+  std::vector<TokenSpec> specs = {
+          {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+          {"NUMBER", "[0-9]+", false, 9},
+          {"WHITESPACE", "[ \t\r\n]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  std::string testInput;
+  for (int i = 0; i < 300; i++) {
+    testInput += "name" + std::to_string(i % 17) + " " + std::to_string(i) + (i % 9 == 0 ? " $\n" : "  ");
+  }
+  std::string fileName = "tmp_lexer_stream.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  SymbolTable expectedSymbols;
+  std::vector<Token> expected;
+  {
+    TwoBufferReader reader(fileName, 16);
+    DfaLexer lexer(dfa, specs, reader, &expectedSymbols);
+    while (true) {
+      Token t = lexer.getNextToken();
+      if (t.type == "END_OF_FILE") break;
+      expected.push_back(t);
+    }
+  }
+
+  auto check = [&](const TokenStream &stream, DfaLexer &lexer) {
+      ASSERT_EQ(stream.size(), expected.size());
+      for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(lexer.typeName(stream.typeIds[i]), expected[i].type);
+        EXPECT_EQ(stream.lexeme(i), expected[i].lexeme);
+        EXPECT_EQ(stream.lengths[i], expected[i].lexeme.size());
+        EXPECT_EQ(stream.lines[i], expected[i].line);
+        EXPECT_EQ(stream.columns[i], expected[i].column);
+        EXPECT_EQ(stream.symbolIds[i], expected[i].symbolId);
+      }
+  };
+
+  {
+    // Стабильные окна: лексемы ссылаются на отображение файла
+    SymbolTable symTable;
+    MmapReader reader(fileName);
+    DfaLexer lexer(dfa, specs, reader, &symTable);
+    TokenStream stream;
+    EXPECT_EQ(lexer.tokenizeAll(stream), expected.size());
+    EXPECT_NE(stream.source, nullptr);
+    EXPECT_TRUE(stream.text.empty());
+    EXPECT_EQ(stream.offsets[1], 6u);
+    check(stream, lexer);
+    EXPECT_EQ(lexer.tokenizeAll(stream), 0u);
+  }
+  {
+    // Двойной буфер, пачками: лексемы копируются в text
+    SymbolTable symTable;
+    TwoBufferReader reader(fileName, 16);
+    DfaLexer lexer(dfa, specs, reader, &symTable);
+    TokenStream stream;
+    size_t batches = 0;
+    while (size_t n = lexer.tokenizeBatch(stream, 64)) {
+      EXPECT_LE(n, 64u);
+      batches++;
+    }
+    EXPECT_EQ(batches, (expected.size() + 63) / 64);
+    EXPECT_EQ(stream.source, nullptr);
+    check(stream, lexer);
+  }
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, LazyPositionsResolveThroughLineIndex) {
+  std::vector<TokenSpec> specs = {
+          {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+          {"NUMBER", "[0-9]+", false, 9},
+          {"WHITESPACE", "[ \t\r\n]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  std::string testInput;
+  for (int i = 0; i < 300; i++) {
+    testInput += std::string(static_cast<size_t>(i % 7), ' ') + "id" + std::to_string(i) + " " +
+                 std::to_string(i * 31) + std::string(static_cast<size_t>(i % 3), '\n');
+  }
+  std::string fileName = "tmp_lexer_lazy_positions.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+  std::vector<CompactToken> expected;
+  {
+    MmapReader reader(fileName);
+    DfaLexer lexer(dfa, specs, reader, nullptr);
+    for (CompactToken t = lexer.getNextCompactToken(); t.typeId != CompactToken::END_OF_FILE_TYPE;
+         t = lexer.getNextCompactToken()) {
+      expected.push_back(t);
+    }
+  }
+  TwoBufferReader reader(fileName, 8);
+  DfaLexer lexer(dfa, specs, reader, nullptr);
+  lexer.setLazyPositions(true);
+  for (const CompactToken &e : expected) {
+    CompactToken t = lexer.getNextCompactToken();
+    ASSERT_EQ(t.offset, e.offset);
+    EXPECT_EQ(t.line, 0);
+    EXPECT_EQ(t.column, 0);
+    TextPosition pos = reader.lineIndex().position(t.offset);
+    EXPECT_EQ(pos.line, static_cast<uint64_t>(e.line));
+    EXPECT_EQ(pos.column, static_cast<uint64_t>(e.column));
+  }
+  EXPECT_EQ(lexer.getNextCompactToken().typeId, CompactToken::END_OF_FILE_TYPE);
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, RollsBackToLastAccept) {
+  std::vector<TokenSpec> specs = {
+          {"FLOAT", "[0-9]+[.][0-9]+", false, 10},
+          {"INT", "[0-9]+", false, 9},
+          {"DOT", "[.]", false, 8},
+          {"IDENT", "[a-z]+", false, 7},
+          {"COMMENT", "[/][*][a-z ]*[*][/]", true, 2},
+          {"WHITESPACE", "[ \t\r\n]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  // «12.x» — автомат доходит до «12.» и откатывается к INT «12»;
+  // «/* ab» — незакрытый комментарий: ни одного допуска, UNKNOWN «/» и разбор дальше
+  std::string unit = "12.x 3.5 7. /* ab\n";
+  std::string testInput;
+  for (int i = 0; i < 40; i++) {
+    testInput += unit;
+  }
+  std::vector<std::pair<std::string, std::string>> unitTokens = {
+          {"INT", "12"}, {"DOT", "."}, {"IDENT", "x"}, {"FLOAT", "3.5"}, {"INT", "7"},
+          {"DOT", "."}, {"UNKNOWN", "/"}, {"UNKNOWN", "*"}, {"IDENT", "ab"}
+  };
+  std::string fileName = "tmp_lexer_rollback.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  auto check = [&](IReader &reader) {
+      DfaLexer lexer(dfa, specs, reader, nullptr);
+      for (int i = 0; i < 40; i++) {
+        for (const auto &[type, lexeme] : unitTokens) {
+          Token t = lexer.getNextToken();
+          ASSERT_EQ(t.type, type) << i;
+          ASSERT_EQ(t.lexeme, lexeme) << i;
+          ASSERT_EQ(t.line, i + 1);
+        }
+      }
+      EXPECT_EQ(lexer.getNextToken().type, "END_OF_FILE");
+  };
+
+  CharOnlyReader charReader(testInput);
+  check(charReader);
+  MmapReader mmapReader(fileName);
+  check(mmapReader);
+  // Маленькие половины: откат часто пересекает границу половин
+  for (size_t bufferSize : {1u, 2u, 3u, 5u, 64u}) {
+    TwoBufferReader bufferReader(fileName, bufferSize);
+    check(bufferReader);
+  }
+  // Канал: вход целиком помещается в буфер канала, поэтому пишем его заранее
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  ASSERT_EQ(::write(fds[1], testInput.data(), testInput.size()), static_cast<ssize_t>(testInput.size()));
+  ::close(fds[1]);
+  PipeReader pipeReader(fds[0], 3);
+  check(pipeReader);
+  ::close(fds[0]);
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, LongIgnoredRunDoesNotRecurse) {
+  std::vector<TokenSpec> specs = {
+          {"IDENT", "[a-z]+", false, 10},
+          {"COMMENT", "[/][*][a-z]*[*][/]", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  std::string testInput;
+  for (int i = 0; i < 2000000; i++) {
+    testInput += "/**/";
+  }
+  testInput += "end";
+  std::string fileName = "tmp_lexer_ignored_run.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+  MmapReader reader(fileName);
+  DfaLexer lexer(dfa, specs, reader, nullptr);
+  CompactToken tok = lexer.getNextCompactToken();
+  EXPECT_EQ(tok.lexeme, "end");
+  EXPECT_EQ(tok.offset, testInput.size() - 3);
+  EXPECT_EQ(lexer.getNextCompactToken().typeId, CompactToken::END_OF_FILE_TYPE);
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, LinearTimeMatchesBacktracking) {
+  std::vector<TokenSpec> specs = {
+          {"A", "a", false, 10},
+          {"AB", "a*b", false, 9},
+          {"ABC", "(ab)+c", false, 8},
+          {"SPACE", "[ ]+", true, 1}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  std::mt19937 rng(11);
+  const char alphabet[] = "aaaabbc ";
+  std::string testInput;
+  for (int i = 0; i < 6000; i++) {
+    testInput += alphabet[rng() % 8];
+  }
+  std::string fileName = "tmp_lexer_linear.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  auto collect = [&](IReader &reader, bool linear) {
+      DfaLexer lexer(dfa, specs, reader, nullptr);
+      lexer.setLinearTime(linear);
+      std::vector<std::pair<uint16_t, uint64_t>> tokens;
+      for (;;) {
+        CompactToken tok = lexer.getNextCompactToken();
+        if (tok.typeId == CompactToken::END_OF_FILE_TYPE) break;
+        tokens.emplace_back(tok.typeId, tok.offset);
+      }
+      return tokens;
+  };
+
+  MmapReader plainReader(fileName);
+  auto expected = collect(plainReader, false);
+  MmapReader mmapReader(fileName);
+  EXPECT_EQ(collect(mmapReader, true), expected);
+  TwoBufferReader bufferReader(fileName, 7);
+  EXPECT_EQ(collect(bufferReader, true), expected);
+  CharOnlyReader charReader(testInput);
+  EXPECT_EQ(collect(charReader, true), expected);
+  std::remove(fileName.c_str());
+}
+
+TEST(DfaLexerTest, LinearTimeOnPathologicalInput) {
+  std::vector<TokenSpec> specs = {
+          {"A", "a", false, 10},
+          {"AB", "a*b", false, 9}
+  };
+  DFA dfa = buildUnminimizedDFA(specs);
+  // Без мемоизации каждый из n токенов сканирует вход до конца: ~n^2/2 = 3*10^10 шагов
+  std::string testInput(size_t{1} << 18, 'a');
+  std::string fileName = "tmp_lexer_pathological.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+  MmapReader reader(fileName);
+  DfaLexer lexer(dfa, specs, reader, nullptr);
+  lexer.setLinearTime(true);
+  size_t count = 0;
+  for (;;) {
+    CompactToken tok = lexer.getNextCompactToken();
+    if (tok.typeId == CompactToken::END_OF_FILE_TYPE) break;
+    ASSERT_EQ(tok.lexeme, "a");
+    ASSERT_EQ(tok.offset, count);
+    count++;
+  }
+  EXPECT_EQ(count, testInput.size());
+  std::remove(fileName.c_str());
+}
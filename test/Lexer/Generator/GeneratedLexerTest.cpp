@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include "IdentLexer.h"
+#include "IdentNumberLexer.h"
+#include "../../../Lexer/DFA/DFA.h"
+#include "../../../Lexer/TokenSpecification/TokenSpecReader.h"
+#include "../../../Lexer/Generator/DirectCodeGenerator.h"
+#include "../../../SymbolTable/SymbolTable.h"
+#include "../../../Lexer/Reader/TwoBufferReader.h"
+#include "../../../Lexer/Reader/MmapReader.h"
+#include "../../../Lexer/DfaLexer.h"
+#include "../CharOnlyReader.h"
+#include "../TestDFA.h"
+
+static std::vector<Token> collect(ILexer &lexer) {
+  std::vector<Token> tokens;
+  while (true) {
+    Token t = lexer.getNextToken();
+    if (t.type == "END_OF_FILE") break;
+    tokens.push_back(t);
+  }
+  return tokens;
+}
+
+TEST(GeneratedLexerTest, SimpleIdentifiers) {
+  std::string fileName = "tmp_generated_lexer_test.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << "Hello World   Foo123";
+  }
+  SymbolTable symTable;
+  {
+    TwoBufferReader reader(fileName, 8);
+    IdentLexer lexer(reader, &symTable);
+
+    Token t1 = lexer.getNextToken();
+    EXPECT_EQ(t1.type, "IDENT");
+    EXPECT_EQ(t1.lexeme, "Hello");
+    EXPECT_EQ(t1.symbolId, 0);
+
+    Token t2 = lexer.getNextToken();
+    EXPECT_EQ(t2.type, "IDENT");
+    EXPECT_EQ(t2.lexeme, "World");
+    EXPECT_EQ(t2.column, 7);
+
+    Token t3 = lexer.getNextToken();
+    EXPECT_EQ(t3.type, "IDENT");
+    EXPECT_EQ(t3.lexeme, "Foo");
+
+    for (const char *digit : {"1", "2", "3"}) {
+      Token t = lexer.getNextToken();
+      EXPECT_EQ(t.type, "UNKNOWN");
+      EXPECT_EQ(t.lexeme, digit);
+    }
+
+    Token eof = lexer.getNextToken();
+    EXPECT_EQ(eof.type, "END_OF_FILE");
+  }
+  std::remove(fileName.c_str());
+}
+
+TEST(GeneratedLexerTest, IdentAndNumber) {
+  CharOnlyReader reader("x1 234\n  __foo 99bar");
+  IdentNumberLexer lexer(reader, nullptr);
+
+  Token t1 = lexer.getNextToken();
+  EXPECT_EQ(t1.type, "IDENT");
+  EXPECT_EQ(t1.lexeme, "x1");
+
+  Token t2 = lexer.getNextToken();
+  EXPECT_EQ(t2.type, "NUMBER");
+  EXPECT_EQ(t2.lexeme, "234");
+  EXPECT_EQ(t2.column, 4);
+
+  Token t3 = lexer.getNextToken();
+  EXPECT_EQ(t3.type, "IDENT");
+  EXPECT_EQ(t3.lexeme, "__foo");
+  EXPECT_EQ(t3.line, 2);
+  EXPECT_EQ(t3.column, 3);
+
+  Token t4 = lexer.getNextToken();
+  EXPECT_EQ(t4.type, "NUMBER");
+  EXPECT_EQ(t4.lexeme, "99");
+
+  Token t5 = lexer.getNextToken();
+  EXPECT_EQ(t5.type, "IDENT");
+  EXPECT_EQ(t5.lexeme, "bar");
+
+  Token eof = lexer.getNextToken();
+  EXPECT_EQ(eof.type, "END_OF_FILE");
+}
+
+TEST(GeneratedLexerTest, MatchesRuntimeDfaLexer) {
+  TokenSpecReader tsReader;
+  std::vector<TokenSpec> specs = tsReader.readTokenSpecs(IDENT_NUMBER_SPECS);
+  sortTokenSpecsByPriority(specs);
+  DFA dfa = buildUnminimizedDFA(specs);
+
+  std::string testInput;
+  for (int i = 0; i < 200; i++) {
+    testInput += "while (x_" + std::to_string(i) + " <= " + std::to_string(i * 7) + ") {";
+    testInput += (i % 5 == 0 ? "\n" : " ");
+    testInput += "if (a==b) return iffy; else y = y*2 + $" + std::string(i % 3, ' ') + ";}\n";
+    // «3.x» — автомат доходит до «3.» и откатывается к NUMBER «3»
+    testInput += "z = 3.x + 2.5;\n";
+  }
+  std::string fileName = "tmp_generated_lexer_compare.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  SymbolTable runtimeSymbols;
+  CharOnlyReader runtimeReader(testInput);
+  DfaLexer runtimeLexer(dfa, specs, runtimeReader, &runtimeSymbols);
+  auto expected = collect(runtimeLexer);
+
+  SymbolTable charSymbols;
+  CharOnlyReader charReader(testInput);
+  IdentNumberLexer charLexer(charReader, &charSymbols);
+  TwoBufferReader bufferReader(fileName, 5);
+  IdentNumberLexer bufferLexer(bufferReader, nullptr);
+  MmapReader mmapReader(fileName);
+  IdentNumberLexer mmapLexer(mmapReader, nullptr);
+  auto fromChars = collect(charLexer);
+  auto fromBuffer = collect(bufferLexer);
+  auto fromMmap = collect(mmapLexer);
+
+  ASSERT_GT(expected.size(), 1000u);
+  ASSERT_EQ(fromChars.size(), expected.size());
+  ASSERT_EQ(fromBuffer.size(), expected.size());
+  ASSERT_EQ(fromMmap.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(fromChars[i].type, expected[i].type);
+    EXPECT_EQ(fromChars[i].lexeme, expected[i].lexeme);
+    EXPECT_EQ(fromChars[i].line, expected[i].line);
+    EXPECT_EQ(fromChars[i].column, expected[i].column);
+    EXPECT_EQ(fromChars[i].symbolId, expected[i].symbolId);
+    EXPECT_EQ(fromBuffer[i].type, expected[i].type);
+    EXPECT_EQ(fromBuffer[i].lexeme, expected[i].lexeme);
+    EXPECT_EQ(fromBuffer[i].line, expected[i].line);
+    EXPECT_EQ(fromBuffer[i].column, expected[i].column);
+    EXPECT_EQ(fromMmap[i].lexeme, expected[i].lexeme);
+    EXPECT_EQ(fromMmap[i].column, expected[i].column);
+  }
+  std::remove(fileName.c_str());
+}
+
+TEST(GeneratedLexerTest, GeneratorRejectsBadInput) {
+  DFA dfa;
+  dfa.states.push_back({false, -1});
+  dfa.transitions.assign(1, -1);
+  DirectCodeGenerator generator;
+  EXPECT_THROW(generator.generate(dfa, {}, "Lexer"), std::runtime_error);
+  EXPECT_THROW(generator.generate(dfa, {{"A", "a", false, 1}}, "1Lexer"), std::runtime_error);
+  auto out = generator.generate(dfa, {{"A", "a", false, 1}}, "TinyLexer");
+  EXPECT_NE(out.header.find("class TinyLexer : public ILexer"), std::string::npos);
+  EXPECT_NE(out.source.find("S0:"), std::string::npos);
+}
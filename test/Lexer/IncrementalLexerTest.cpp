@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../../Lexer/TokenSpecification/TokenSpec.h"
+#include "../../Lexer/Reader/StringViewReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Lexer/IncrementalLexer.h"
+#include "TestDFA.h"
+
+static const std::vector<TokenSpec> SPECS = {
+        {"WHITESPACE", "[ \t\r\n]+", true, 1},
+        {"COMMENT", "[/][*]([ -)+-~\t\r\n]|[*]+[ -)+-.0-~\t\r\n])*[*]+[/]", true, 2},
+        {"STRING", "[\"]([ !#-~])*[\"]", false, 3},
+        {"KEYWORD", "(int|return|while|if)", false, 4},
+        {"OP", "([+]|[-]|[*]|[/]|[=]|[<]|[;]|[,]|[.]|\\(|\\)|[{]|[}])", false, 5},
+        {"FLOAT", "[0-9]+[.][0-9]+", false, 6},
+        {"NUMBER", "[0-9]+", false, 7},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 8},
+};
+
+static std::string makeInput(int lines) {
+  std::string text;
+  for (int i = 0; i < lines; i++) {
+    text += "int x" + std::to_string(i % 50) + " = 3.25 * y" + std::to_string(i) + "; /* c */ \"s\"\n";
+  }
+  return text;
+}
+
+/**
+ * @brief Сравнивает поток инкрементального лексера с разбором всего текста с нуля.
+ */
+static void expectSameAsFullLex(const DFA &dfa, const IncrementalLexer &incremental) {
+  StringViewReader reader(incremental.text());
+  DfaLexer lexer(dfa, SPECS, reader, nullptr);
+  TokenStream expected;
+  lexer.tokenizeAll(expected);
+  const TokenStream &actual = incremental.tokens();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(actual.typeIds[i], expected.typeIds[i]) << i;
+    ASSERT_EQ(actual.offsets[i], expected.offsets[i]) << i;
+    ASSERT_EQ(actual.lexeme(i), expected.lexeme(i)) << i;
+    ASSERT_EQ(actual.lines[i], expected.lines[i]) << i;
+    ASSERT_EQ(actual.columns[i], expected.columns[i]) << i;
+  }
+}
+
+TEST(IncrementalLexerTest, RandomEditsMatchFullLex) {
+  DFA dfa = buildDFA(SPECS);
+  IncrementalLexer incremental(dfa, SPECS, makeInput(60));
+  expectSameAsFullLex(dfa, incremental);
+
+  // Вставки, которые открывают и закрывают комментарии и строки, рвут числа и строки
+  const std::vector<std::string> snippets = {
+          "/*", "*/", "\"", "\n", "1.", ".5", "x", " ", "while", "7", "*", "", "/* a */ b"
+  };
+  std::mt19937 rng(5);
+  for (int step = 0; step < 300; step++) {
+    const std::string &text = incremental.text();
+    uint64_t offset = rng() % (text.size() + 1);
+    uint64_t removed = std::min<uint64_t>(rng() % 4, text.size() - offset);
+    const std::string &inserted = snippets[rng() % snippets.size()];
+    incremental.edit(offset, removed, inserted);
+    ASSERT_NO_FATAL_FAILURE(expectSameAsFullLex(dfa, incremental)) << "step " << step;
+  }
+}
+
+TEST(IncrementalLexerTest, RelexesOnlyAroundEdit) {
+  DFA dfa = buildDFA(SPECS);
+  IncrementalLexer incremental(dfa, SPECS, makeInput(2000));
+  const size_t before = incremental.tokens().size();
+
+  // Переименование идентификатора в середине файла
+  const uint64_t offset = incremental.text().find("y1000;");
+  auto change = incremental.edit(offset, 5, "renamed");
+  EXPECT_LE(change.removedTokens, 3u);
+  EXPECT_EQ(change.insertedTokens, change.removedTokens);
+  EXPECT_LE(change.relexEnd - change.relexBegin, 32u);
+  EXPECT_EQ(incremental.tokens().size(), before);
+  EXPECT_EQ(incremental.tokens().lexeme(change.firstToken), "renamed");
+
+  // Новая строка в начале: всё, что дальше, только сдвигается
+  change = incremental.edit(0, 0, "int z;\n");
+  EXPECT_EQ(change.firstToken, 0u);
+  EXPECT_EQ(change.insertedTokens, change.removedTokens + 3);
+  EXPECT_EQ(incremental.tokens().lines.back(), 2001);
+  expectSameAsFullLex(dfa, incremental);
+
+  // Открытый комментарий поглощает текст до ближайшего «*/» — перелексируется только он
+  const uint64_t line = incremental.text().find("int x7 = 3.25 * y1007;");
+  change = incremental.edit(line, 0, "/*");
+  // Семь токенов строки ушли в комментарий; потоки сходятся на конце следующей за ним строки "s"
+  EXPECT_EQ(change.removedTokens, 8u);
+  EXPECT_EQ(change.insertedTokens, 1u);
+  EXPECT_LE(change.relexEnd - change.relexBegin, 64u);
+  expectSameAsFullLex(dfa, incremental);
+}
+
+TEST(IncrementalLexerTest, EditOutsideTextThrows) {
+  DFA dfa = buildDFA(SPECS);
+  IncrementalLexer incremental(dfa, SPECS, "int x;");
+  EXPECT_THROW(incremental.edit(7, 0, "y"), std::runtime_error);
+  EXPECT_THROW(incremental.edit(4, 3, ""), std::runtime_error);
+  incremental.edit(6, 0, " y");
+  EXPECT_EQ(incremental.tokens().size(), 4u);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "../../Lexer/DFA/DFA.h"
+#include "../../Lexer/DFA/LazyDFA.h"
+#include "../../Lexer/TokenSpecification/TokenSpec.h"
+#include "../../Lexer/DFA/DFABuiler.h"
+#include "../../SymbolTable/SymbolTable.h"
+#include "../../Lexer/Reader/TwoBufferReader.h"
+#include "../../Lexer/Reader/MmapReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Lexer/LazyDfaLexer.h"
+#include "TestDFA.h"
+
+static const std::vector<TokenSpec> SPECS = {
+        {"IF", "if", false, 20},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 10},
+        {"NUMBER", "[0-9]+", false, 9},
+        {"HEX", "0[xX][0-9a-fA-F]+", false, 9},
+        {"PLUSPLUS", "[+][+]", false, 5},
+        {"PLUS", "[+]", false, 4},
+        {"WHITESPACE", "[ \t\r\n]+", true, 1}
+};
+
+static std::string makeInput() {
+  std::string text;
+  for (int i = 0; i < 150; i++) {
+    text += "if x_" + std::to_string(i) + " ++ 0x" + std::to_string(i * 13) + "+" + std::to_string(i) + " ?";
+    text += (i % 7 == 0 ? "\n" : "  ");
+  }
+  return text;
+}
+
+template <typename Lexer>
+static std::vector<Token> collect(Lexer &lexer) {
+  std::vector<Token> tokens;
+  while (true) {
+    Token t = lexer.getNextToken();
+    if (t.type == "END_OF_FILE") break;
+    tokens.push_back(t);
+  }
+  return tokens;
+}
+
+static void expectSameTokens(const std::vector<Token> &actual, const std::vector<Token> &expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(actual[i].type, expected[i].type) << i;
+    EXPECT_EQ(actual[i].lexeme, expected[i].lexeme) << i;
+    EXPECT_EQ(actual[i].line, expected[i].line) << i;
+    EXPECT_EQ(actual[i].column, expected[i].column) << i;
+    EXPECT_EQ(actual[i].symbolId, expected[i].symbolId) << i;
+  }
+}
+
+TEST(LazyDfaLexerTest, SameTokensAsDfaLexer) {
+  NFA nfa = buildNFA(SPECS);
+  DFA dfa = SubsetConstructionDFABuilder().buildFromNFA(nfa);
+  std::string fileName = "tmp_lazy_lexer.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << makeInput();
+  }
+
+  SymbolTable eagerSymbols;
+  MmapReader eagerReader(fileName);
+  DfaLexer eager(dfa, SPECS, eagerReader, &eagerSymbols);
+  auto expected = collect(eager);
+
+  SymbolTable lazySymbols;
+  TwoBufferReader lazyReader(fileName, 16);
+  LazyDFA lazyDfa(nfa);
+  LazyDfaLexer lazy(lazyDfa, SPECS, lazyReader, &lazySymbols);
+  expectSameTokens(collect(lazy), expected);
+  EXPECT_LE(lazyDfa.cachedStates(), dfa.states.size());
+  std::remove(fileName.c_str());
+}
+
+TEST(LazyDfaLexerTest, SmallCacheBudget) {
+  NFA nfa = buildNFA(SPECS);
+  DFA dfa = SubsetConstructionDFABuilder().buildFromNFA(nfa);
+  std::string fileName = "tmp_lazy_lexer_small.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << makeInput();
+  }
+
+  MmapReader eagerReader(fileName);
+  DfaLexer eager(dfa, SPECS, eagerReader, nullptr);
+  auto expected = collect(eager);
+
+  MmapReader lazyReader(fileName);
+  LazyDFA lazyDfa(nfa, 1);
+  LazyDfaLexer lazy(lazyDfa, SPECS, lazyReader, nullptr);
+  expectSameTokens(collect(lazy), expected);
+  EXPECT_GT(lazyDfa.stats().cacheFlushes, 0u);
+  std::remove(fileName.c_str());
+}
@@ -44,23 +44,19 @@ TEST(NFATest, SingleLiteral) {
   EXPECT_EQ(nfa.startState, 0);
   EXPECT_EQ(nfa.acceptState, 1);
 
-  const auto &startSt = nfa.states[0];
   const auto &acceptSt = nfa.states[1];
 
   EXPECT_TRUE(acceptSt.isAccept);
 
   unsigned char c = static_cast<unsigned char>('a');
 
-  ASSERT_EQ(startSt.transitions[c].size(), 1u);
-  EXPECT_EQ(startSt.transitions[c][0], 1);
+  auto edges = nfa.edgesOf(0);
+  ASSERT_EQ(edges.size(), 1u);
+  EXPECT_EQ(edges[0].lo, c);
+  EXPECT_EQ(edges[0].hi, c);
+  EXPECT_EQ(edges[0].target, 1);
 
-  for (int sym = 0; sym < 256; sym++) {
-    if (sym != c) {
-      EXPECT_TRUE(startSt.transitions[sym].empty());
-    }
-  }
-
-  EXPECT_TRUE(startSt.epsilon.empty());
+  EXPECT_TRUE(nfa.epsilonOf(0).empty());
 }
 
 TEST(NFATest, Concatenation) {
@@ -77,11 +73,11 @@ TEST(NFATest, Concatenation) {
   unsigned char bChar = static_cast<unsigned char>('b');
   bool foundTransitionB = false;
   for (int stIndex = 0; stIndex < (int)nfa.states.size(); stIndex++) {
-    const auto &st = nfa.states[stIndex];
-    if (!st.transitions[bChar].empty())
-    {
-      foundTransitionB = true;
-      EXPECT_EQ(st.transitions[bChar][0], 3);
+    for (const NFAEdge &edge : nfa.edgesOf(stIndex)) {
+      if (edge.lo <= bChar && bChar <= edge.hi) {
+        foundTransitionB = true;
+        EXPECT_EQ(edge.target, 3);
+      }
     }
   }
   EXPECT_TRUE(foundTransitionB);
@@ -96,9 +92,7 @@ TEST(NFATest, Alternative) {
   EXPECT_EQ(nfa.startState, static_cast<int>(nfa.states.size()) - 2);
   EXPECT_TRUE(nfa.states.back().isAccept);
 
-  const auto &startSt = nfa.states[nfa.startState];
-
-  ASSERT_GE(startSt.epsilon.size(), 2u); // минимум 2 epsilon-перехода
+  ASSERT_GE(nfa.epsilonOf(nfa.startState).size(), 2u); // минимум 2 epsilon-перехода
   EXPECT_TRUE(nfa.states[nfa.states.size() - 1].isAccept);
 }
 
@@ -112,10 +106,9 @@ TEST(NFATest, Star) {
 
   EXPECT_GE(nfa.states.size(), 4u);
 
-  const auto &startSt = nfa.states[nfa.startState];
   bool hasEpsToAccept = false;
 
-  for (int e : startSt.epsilon) {
+  for (int e : nfa.epsilonOf(nfa.startState)) {
     if (e == nfa.acceptState) {
       hasEpsToAccept = true;
       break;
@@ -125,6 +118,48 @@ TEST(NFATest, Star) {
   EXPECT_TRUE(hasEpsToAccept);
 }
 
+TEST(NFATest, PlusReusesOperand) {
+  ThompsonNFABuilder builder;
+  auto ast = std::make_shared<RegexAST>(RegexNodeType::Plus);
+  ast->left = makeLiteralNode('a');
+
+  NFA nfa = builder.buildFromAST(ast);
+
+  // Операнд не копируется: 2 состояния литерала + новое принимающее
+  EXPECT_EQ(nfa.states.size(), 3u);
+  EXPECT_TRUE(nfa.states[nfa.acceptState].isAccept);
+  EXPECT_FALSE(nfa.states[1].isAccept);
+
+  bool loopsBack = false;
+  for (int e : nfa.epsilonOf(1)) {
+    if (e == nfa.startState) {
+      loopsBack = true;
+    }
+  }
+  EXPECT_TRUE(loopsBack);
+}
+
+TEST(NFATest, CharClassAsRanges) {
+  ThompsonNFABuilder builder;
+  auto ast = std::make_shared<RegexAST>(RegexNodeType::CharClass);
+  ast->charClass = "a-z0-9_x";
+
+  NFA nfa = builder.buildFromAST(ast);
+
+  ASSERT_EQ(nfa.states.size(), 2u);
+  auto edges = nfa.edgesOf(nfa.startState);
+  ASSERT_EQ(edges.size(), 3u);
+  EXPECT_EQ(edges[0].lo, '0');
+  EXPECT_EQ(edges[0].hi, '9');
+  EXPECT_EQ(edges[1].lo, '_');
+  EXPECT_EQ(edges[1].hi, '_');
+  EXPECT_EQ(edges[2].lo, 'a');
+  EXPECT_EQ(edges[2].hi, 'z');
+  for (const NFAEdge &edge : edges) {
+    EXPECT_EQ(edge.target, nfa.acceptState);
+  }
+}
+
 TEST(NFATest, CombinedNFA) {
   ThompsonNFABuilder builder;
   auto astA = makeLiteralNode('a');
@@ -138,7 +173,7 @@ TEST(NFATest, CombinedNFA) {
   EXPECT_GE(combined.states.size(), 7u);
   EXPECT_EQ(combined.startState, 0);
   EXPECT_EQ(combined.acceptState, -1);
-  ASSERT_GE(combined.states[0].epsilon.size(), 2u);
+  ASSERT_GE(combined.epsilonOf(0).size(), 2u);
 
   bool foundTokenIndex10 = false;
 
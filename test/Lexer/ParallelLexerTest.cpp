@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../../Lexer/TokenSpecification/TokenSpec.h"
+#include "../../SymbolTable/SymbolTable.h"
+#include "../../Lexer/Reader/StringViewReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Lexer/ParallelLexer.h"
+#include "TestDFA.h"
+
+static const std::vector<TokenSpec> SPECS = {
+        {"WHITESPACE", "[ \t\r\n]+", true, 1},
+        {"COMMENT", "[/][*]([ -)+-~\t\r\n]|[*]+[ -)+-.0-~\t\r\n])*[*]+[/]", true, 2},
+        {"STRING", "[\"]([ !#-~])*[\"]", false, 3},
+        {"KEYWORD", "(int|return|while|if)", false, 4},
+        {"OP", "([+]|[-]|[*]|[/]|[=]|[<]|[;]|[,]|\\(|\\)|[{]|[}])", false, 5},
+        {"NUMBER", "[0-9]+", false, 6},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 7},
+};
+
+/**
+ * @brief Вход с длинными комментариями и строками, внутри которых встречаются переводы
+ *        строк, «код» и обрывки комментариев, — границы кусков часто попадают внутрь токенов.
+ */
+static std::string makeInput(unsigned seed, int pieces) {
+  std::mt19937 rng(seed);
+  std::string text;
+  for (int i = 0; i < pieces; i++) {
+    switch (rng() % 6) {
+      case 0:
+        text += "int x" + std::to_string(rng() % 50) + " = " + std::to_string(rng()) + ";\n";
+        break;
+      case 1: {
+        text += "/* ";
+        int lines = static_cast<int>(rng() % 30);
+        for (int k = 0; k < lines; k++) {
+          text += "while (a < b) { x = \"s\" * 2; } ** /\n";
+        }
+        text += " */";
+        break;
+      }
+      case 2:
+        text += "\"string /* not a comment */ x = 1;\" ";
+        break;
+      case 3:
+        text += "  return f(a, b) - 7;\n\t";
+        break;
+      case 4:
+        text += "@ $ #\n";
+        break;
+      default:
+        text += std::string(rng() % 40, ' ') + "\n";
+        break;
+    }
+  }
+  return text;
+}
+
+static void expectSameAsSequential(const DFA &dfa, const std::string &input, unsigned threads, size_t minChunk) {
+  // Лексемы expected ссылаются прямо на input
+  StringViewReader reader(input);
+  TokenStream expected;
+  SymbolTable expectedSymbols;
+  DfaLexer sequential(dfa, SPECS, reader, &expectedSymbols);
+  sequential.tokenizeAll(expected);
+
+  TokenStream actual;
+  SymbolTable actualSymbols;
+  ParallelLexer parallel(dfa, SPECS, threads, minChunk);
+  EXPECT_EQ(parallel.tokenize(input, actual, &actualSymbols), expected.size());
+  EXPECT_LE(parallel.lastStats().chunks, threads);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  EXPECT_EQ(actual.typeIds, expected.typeIds);
+  EXPECT_EQ(actual.offsets, expected.offsets);
+  EXPECT_EQ(actual.lengths, expected.lengths);
+  EXPECT_EQ(actual.lines, expected.lines);
+  EXPECT_EQ(actual.columns, expected.columns);
+  EXPECT_EQ(actual.symbolIds, expected.symbolIds);
+  for (size_t i = 0; i < actual.size(); i++) {
+    ASSERT_EQ(actual.lexeme(i), expected.lexeme(i)) << i;
+  }
+}
+
+TEST(ParallelLexerTest, MatchesSequentialLexer) {
+  DFA dfa = buildDFA(SPECS);
+  for (unsigned seed = 1; seed <= 5; seed++) {
+    std::string input = makeInput(seed, 400);
+    for (unsigned threads : {1u, 2u, 3u, 8u, 32u}) {
+      SCOPED_TRACE("seed " + std::to_string(seed) + ", threads " + std::to_string(threads));
+      expectSameAsSequential(dfa, input, threads, 64);
+    }
+  }
+}
+
+TEST(ParallelLexerTest, ResyncsInsideLongComment) {
+  DFA dfa = buildDFA(SPECS);
+  // Комментарий перекрывает несколько кусков: их спекулятивные потоки ложны целиком
+  std::string input = "a = 1;\n/*";
+  for (int i = 0; i < 200; i++) {
+    input += " x = \"y\"; if (z) { return 0; }\n";
+  }
+  input += "*/ b = 2;\nc\n";
+  expectSameAsSequential(dfa, input, 8, 16);
+
+  ParallelLexer lexer(dfa, SPECS, 8, 16);
+  TokenStream stream;
+  lexer.tokenize(input, stream, nullptr);
+  EXPECT_EQ(stream.size(), 9u);
+  EXPECT_GT(lexer.lastStats().chunks, 2u);
+  EXPECT_LT(lexer.lastStats().syncedChunks, lexer.lastStats().chunks);
+  EXPECT_EQ(stream.symbolIds, std::vector<int>(stream.size(), -1));
+}
+
+TEST(ParallelLexerTest, EdgeCases) {
+  DFA dfa = buildDFA(SPECS);
+  expectSameAsSequential(dfa, "", 4, 1);
+  expectSameAsSequential(dfa, "   \n\n  ", 4, 1);
+  expectSameAsSequential(dfa, "x", 4, 1);
+  expectSameAsSequential(dfa, "/* unterminated\n comment", 4, 4);
+  expectSameAsSequential(dfa, "\"unterminated string", 4, 4);
+
+  ParallelLexer lexer(dfa, SPECS, 2, 1);
+  TokenStream stream;
+  lexer.tokenize("a b", stream, nullptr);
+  EXPECT_THROW(lexer.tokenize("c", stream, nullptr), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include <string>
+#include "../../../Lexer/Reader/LineIndex.h"
+#include "../../../Lexer/Reader/MmapReader.h"
+#include "../../../Lexer/Reader/TwoBufferReader.h"
+
+/**
+ * @brief Позиции, посчитанные побайтово, как это делали ридеры раньше.
+ */
+static std::vector<TextPosition> naivePositions(const std::string &text) {
+  std::vector<TextPosition> result;
+  TextPosition pos;
+  for (char c : text) {
+    result.push_back(pos);
+    if (c == '\n') {
+      pos.line++;
+      pos.column = 1;
+    } else {
+      pos.column++;
+    }
+  }
+  result.push_back(pos);
+  return result;
+}
+
+static std::string randomText(unsigned seed, size_t size) {
+  std::mt19937 rng(seed);
+  std::string text;
+  for (size_t i = 0; i < size; i++) {
+    // Иногда длинные строки, иногда серии пустых
+    unsigned r = rng() % 100;
+    text += r < 4 ? '\n' : (r < 6 ? '\0' : static_cast<char>('a' + r % 26));
+    if (r == 99) {
+      text.append(rng() % 70, '\n');
+    }
+  }
+  return text;
+}
+
+TEST(LineIndexTest, MatchesNaiveCounting) {
+  for (unsigned seed = 1; seed <= 4; seed++) {
+    std::string text = randomText(seed, 3000 + seed * 517);
+    LineIndex index(text);
+    auto expected = naivePositions(text);
+    EXPECT_EQ(index.size(), text.size());
+    EXPECT_EQ(index.lineCount(), expected.back().line);
+    size_t hint = 0;
+    for (size_t offset = 0; offset <= text.size(); offset++) {
+      TextPosition byBinarySearch = index.position(offset);
+      TextPosition byHint = index.position(offset, hint);
+      ASSERT_EQ(byBinarySearch.line, expected[offset].line) << offset;
+      ASSERT_EQ(byBinarySearch.column, expected[offset].column) << offset;
+      ASSERT_EQ(byHint.line, expected[offset].line) << offset;
+      ASSERT_EQ(byHint.column, expected[offset].column) << offset;
+      EXPECT_EQ(index.lineStart(byBinarySearch.line), offset - (byBinarySearch.column - 1));
+    }
+    // Подсказка после запроса «назад» или далеко вперёд не ломает ответ
+    std::mt19937 rng(seed);
+    for (int i = 0; i < 500; i++) {
+      size_t offset = rng() % (text.size() + 1);
+      TextPosition p = index.position(offset, hint);
+      ASSERT_EQ(p.line, expected[offset].line);
+      ASSERT_EQ(p.column, expected[offset].column);
+    }
+  }
+}
+
+TEST(LineIndexTest, AppendEqualsWholeBuild) {
+  std::string text = randomText(7, 10000);
+  LineIndex whole(text);
+  LineIndex parts;
+  size_t pos = 0;
+  for (size_t step = 1; pos < text.size(); step = step * 3 % 97 + 1) {
+    size_t n = std::min(step, text.size() - pos);
+    parts.append(text.data() + pos, n);
+    pos += n;
+  }
+  EXPECT_EQ(parts.newlines(), whole.newlines());
+  EXPECT_EQ(parts.size(), whole.size());
+}
+
+TEST(LineIndexTest, AdvanceMatchesNaiveCounting) {
+  std::string text = randomText(11, 8000);
+  auto expected = naivePositions(text);
+  TextPosition pos;
+  size_t offset = 0;
+  for (size_t step = 0; offset < text.size(); step = step * 5 % 131 + 1) {
+    size_t n = std::min(step, text.size() - offset);
+    LineIndex::advance(pos, text.data() + offset, n);
+    offset += n;
+    ASSERT_EQ(pos.line, expected[offset].line) << offset;
+    ASSERT_EQ(pos.column, expected[offset].column) << offset;
+  }
+}
+
+TEST(LineIndexTest, EmptyInput) {
+  LineIndex index{std::string_view()};
+  EXPECT_EQ(index.lineCount(), 1u);
+  EXPECT_EQ(index.position(0).line, 1u);
+  EXPECT_EQ(index.position(0).column, 1u);
+}
+
+TEST(LineIndexTest, ReadersAnswerFromIndex) {
+  std::string text = "ab\n\ncde\nf";
+  for (int i = 0; i < 2000; i++) {
+    text += "line " + std::to_string(i) + "\n";
+  }
+  std::string path = "test_line_index_reader.txt";
+  {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << text;
+  }
+  auto expected = naivePositions(text);
+  MmapReader mmapReader(path);
+  TwoBufferReader bufferReader(path, 64);
+  for (size_t offset = 0; offset < text.size(); offset++) {
+    ASSERT_EQ(static_cast<uint64_t>(mmapReader.getLine()), expected[offset].line) << offset;
+    ASSERT_EQ(static_cast<uint64_t>(mmapReader.getColumn()), expected[offset].column) << offset;
+    ASSERT_EQ(static_cast<uint64_t>(bufferReader.getLine()), expected[offset].line) << offset;
+    ASSERT_EQ(static_cast<uint64_t>(bufferReader.getColumn()), expected[offset].column) << offset;
+    // Чередуем посимвольное чтение и сдвиг окна
+    if (offset % 2) {
+      mmapReader.getChar();
+      bufferReader.getChar();
+    } else {
+      mmapReader.advance(1);
+      bufferReader.window();
+      bufferReader.advance(1);
+    }
+  }
+  EXPECT_EQ(bufferReader.lineIndex().newlines(), LineIndex(text).newlines());
+  EXPECT_EQ(mmapReader.lineIndex().newlines(), LineIndex(text).newlines());
+  std::remove(path.c_str());
+}
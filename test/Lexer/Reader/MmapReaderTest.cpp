@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include "../../../Lexer/Reader/MmapReader.h"
+
+static std::string writeTempFile(const std::string& content, const std::string& fileName) {
+  std::ofstream ofs(fileName);
+  ofs << content;
+  return fileName;
+}
+
+TEST(MmapReaderTest, PeekCharDoesNotAdvance) {
+  std::string text = "ABCDE";
+  std::string path = writeTempFile(text, "test_mmap_peek_char.txt");
+  MmapReader reader(path);
+
+  char pc0 = reader.peekChar(0);
+  EXPECT_EQ(pc0, 'A');
+  char g0 = reader.getChar();
+  EXPECT_EQ(g0, 'A');
+
+  char pc1 = reader.peekChar(0);
+  EXPECT_EQ(pc1, 'B');
+  char g1 = reader.getChar();
+  EXPECT_EQ(g1, 'B');
+
+  char pc2 = reader.peekChar(0);
+  EXPECT_EQ(pc2, 'C');
+  char pc2again = reader.peekChar(0);
+  EXPECT_EQ(pc2again, 'C');
+  char g2 = reader.getChar();
+  EXPECT_EQ(g2, 'C');
+
+  char g3 = reader.getChar();
+  EXPECT_EQ(g3, 'D');
+
+  char g4 = reader.getChar();
+  EXPECT_EQ(g4, 'E');
+
+  char g5 = reader.getChar();
+  EXPECT_EQ(g5, '\0');
+  EXPECT_TRUE(reader.isEOF());
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapReaderTest, CheckLineColumn) {
+  std::string text = "abc\nxyz\n123";
+  std::string path = writeTempFile(text, "test_mmap_line_col.txt");
+  MmapReader reader(path);
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 1);
+
+  char c1 = reader.getChar();
+  EXPECT_EQ(c1, 'a');
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 2);
+
+  char c2 = reader.getChar();
+  EXPECT_EQ(c2, 'b');
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 3);
+
+  char c3 = reader.getChar();
+  EXPECT_EQ(c3, 'c');
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 4);
+
+  char c4 = reader.getChar();
+  EXPECT_EQ(c4, '\n');
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 1);
+
+  char c5 = reader.getChar();
+  EXPECT_EQ(c5, 'x');
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 2);
+
+  char c6 = reader.getChar();
+  EXPECT_EQ(c6, 'y');
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 3);
+
+  char c7 = reader.getChar();
+  EXPECT_EQ(c7, 'z');
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 4);
+
+  char c8 = reader.getChar();
+  EXPECT_EQ(c8, '\n');
+  EXPECT_EQ(reader.getLine(), 3);
+  EXPECT_EQ(reader.getColumn(), 1);
+
+  char c9 = reader.getChar();
+  EXPECT_EQ(c9, '1');
+  EXPECT_EQ(reader.getLine(), 3);
+  EXPECT_EQ(reader.getColumn(), 2);
+
+  char c10 = reader.getChar();
+  EXPECT_EQ(c10, '2');
+  EXPECT_EQ(reader.getLine(), 3);
+  EXPECT_EQ(reader.getColumn(), 3);
+
+  char c11 = reader.getChar();
+  EXPECT_EQ(c11, '3');
+  EXPECT_EQ(reader.getLine(), 3);
+  EXPECT_EQ(reader.getColumn(), 4);
+
+  char c12 = reader.getChar();
+  EXPECT_EQ(c12, '\0');
+  EXPECT_TRUE(reader.isEOF());
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapReaderTest, PeekAhead) {
+  std::string text = "ABCDE";
+  std::string path = writeTempFile(text, "test_mmap_peek_ahead.txt");
+  MmapReader reader(path);
+
+  EXPECT_EQ(reader.peekChar(3), 'D');
+  EXPECT_EQ(reader.peekChar(4), 'E');
+  EXPECT_EQ(reader.peekChar(5), '\0');
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getChar(), 'A');
+  EXPECT_EQ(reader.peekChar(3), 'E');
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapReaderTest, EmptyFile) {
+  std::string path = writeTempFile("", "test_mmap_empty.txt");
+  MmapReader reader(path);
+
+  EXPECT_TRUE(reader.isEOF());
+  EXPECT_EQ(reader.peekChar(0), '\0');
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 1);
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapReaderTest, MissingFileThrows) {
+  EXPECT_THROW(MmapReader("no_such_file_for_mmap_reader.txt"), std::runtime_error);
+}
+
+TEST(MmapReaderTest, WindowAndAdvance) {
+  std::string text = "ab\ncd\nef";
+  std::string path = writeTempFile(text, "test_mmap_window.txt");
+  MmapReader reader(path);
+
+  auto w = reader.window();
+  ASSERT_EQ(std::string(w.data(), w.size()), text);
+  reader.advance(4);
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 2);
+  EXPECT_EQ(reader.getChar(), 'd');
+
+  w = reader.window();
+  ASSERT_EQ(std::string(w.data(), w.size()), "\nef");
+  reader.advance(3);
+  EXPECT_EQ(reader.getLine(), 3);
+  EXPECT_EQ(reader.getColumn(), 3);
+  EXPECT_TRUE(reader.window().empty());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+
+  std::remove(path.c_str());
+}
+
+TEST(MmapReaderTest, ResetToAnyOffset) {
+  std::string text = "ab\ncd\nef";
+  std::string path = writeTempFile(text, "test_mmap_reset.txt");
+  MmapReader reader(path);
+
+  reader.mark();
+  reader.advance(text.size());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+  reader.reset(4);
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 2);
+  EXPECT_EQ(reader.getChar(), 'd');
+  EXPECT_THROW(reader.reset(text.size() + 1), std::runtime_error);
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "../../../Lexer/Reader/PipeReader.h"
+
+/**
+ * @brief Канал, в который отдельный поток пишет text кусками по chunk байт.
+ */
+class TextPipe {
+public:
+    TextPipe(std::string text, size_t chunk) : m_text(std::move(text)) {
+      if (::pipe(m_fds) != 0) {
+        throw std::runtime_error("pipe failed");
+      }
+      m_writer = std::thread([this, chunk] {
+          for (size_t pos = 0; pos < m_text.size(); pos += chunk) {
+            size_t n = std::min(chunk, m_text.size() - pos);
+            if (::write(m_fds[1], m_text.data() + pos, n) != static_cast<ssize_t>(n)) {
+              break;
+            }
+          }
+          ::close(m_fds[1]);
+      });
+    }
+
+    ~TextPipe() {
+      m_writer.join();
+      ::close(m_fds[0]);
+    }
+
+    [[nodiscard]] int fd() const { return m_fds[0]; }
+
+private:
+    std::string m_text;
+    int m_fds[2] = {-1, -1};
+    std::thread m_writer;
+};
+
+TEST(PipeReaderTest, ReadsEverythingWithPositions) {
+  std::string text;
+  for (int i = 0; i < 500; i++) {
+    text += "line " + std::to_string(i) + (i % 7 ? "\n" : "\n\n");
+  }
+  TextPipe pipe(text, 13);
+  PipeReader reader(pipe.fd(), 8);
+
+  int line = 1;
+  int column = 1;
+  std::string read;
+  for (size_t i = 0; i < text.size(); i++) {
+    ASSERT_EQ(reader.getLine(), line) << i;
+    ASSERT_EQ(reader.getColumn(), column) << i;
+    ASSERT_EQ(reader.getOffset(), i);
+    char c = i % 3 ? reader.getChar() : reader.peekChar(0);
+    if (i % 3 == 0) {
+      reader.advance(1);
+    }
+    read.push_back(c);
+    if (c == '\n') {
+      line++;
+      column = 1;
+    } else {
+      column++;
+    }
+  }
+  EXPECT_EQ(read, text);
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+}
+
+TEST(PipeReaderTest, MarkKeepsBytesForReset) {
+  std::string text;
+  for (int i = 0; i < 2000; i++) {
+    text.push_back(static_cast<char>('a' + i % 26));
+  }
+  TextPipe pipe(text, 100);
+  PipeReader reader(pipe.fd(), 4);
+
+  reader.advance(0);
+  reader.getChar();
+  reader.mark();
+  // Заглядываем далеко вперёд: буфер растёт, байты от точки сохраняются
+  EXPECT_EQ(reader.peekChar(1000), text[1001]);
+  for (int i = 0; i < 1500; i++) {
+    reader.getChar();
+  }
+  reader.reset(500);
+  EXPECT_EQ(reader.getOffset(), 500u);
+  EXPECT_EQ(reader.getColumn(), 501);
+  EXPECT_EQ(reader.getChar(), text[500]);
+  EXPECT_THROW(reader.reset(0), std::runtime_error);
+
+  std::string rest;
+  for (auto w = reader.window(); !w.empty(); w = reader.window()) {
+    rest.append(w.data(), w.size());
+    reader.advance(w.size());
+  }
+  EXPECT_EQ(rest, text.substr(501));
+}
+
+TEST(PipeReaderTest, EmptyInput) {
+  TextPipe pipe("", 1);
+  PipeReader reader(pipe.fd());
+  EXPECT_TRUE(reader.window().empty());
+  EXPECT_EQ(reader.peekChar(0), '\0');
+  EXPECT_TRUE(reader.isEOF());
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 1);
+}
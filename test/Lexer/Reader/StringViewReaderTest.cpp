@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../../Lexer/Reader/StringViewReader.h"
+
+TEST(StringViewReaderTest, ReadsEverythingWithPositions) {
+  const std::string text = "ab\n\ncd\ne";
+  StringViewReader reader(text);
+  EXPECT_TRUE(reader.hasStableWindows());
+  int line = 1;
+  int column = 1;
+  for (char expected : text) {
+    ASSERT_EQ(reader.getLine(), line);
+    ASSERT_EQ(reader.getColumn(), column);
+    ASSERT_EQ(reader.peekChar(0), expected);
+    ASSERT_EQ(reader.getChar(), expected);
+    if (expected == '\n') {
+      line++;
+      column = 1;
+    } else {
+      column++;
+    }
+  }
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+  EXPECT_EQ(reader.getLine(), 4);
+  EXPECT_EQ(reader.getColumn(), 2);
+}
+
+TEST(StringViewReaderTest, WindowPointsIntoText) {
+  const std::string text = "hello world";
+  StringViewReader reader(text, 6);
+  EXPECT_EQ(reader.getOffset(), 6u);
+  auto w = reader.window();
+  EXPECT_EQ(w.data(), text.data() + 6);
+  EXPECT_EQ(w.size(), 5u);
+  reader.advance(100);
+  EXPECT_EQ(reader.getOffset(), text.size());
+  EXPECT_TRUE(reader.window().empty());
+  // Позиции считаются от начала текста, а не от начального смещения
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 12);
+}
+
+TEST(StringViewReaderTest, ResetToAnyOffset) {
+  const std::string text = "x\ny\nz";
+  StringViewReader reader(text);
+  reader.advance(text.size());
+  EXPECT_EQ(reader.getLine(), 3);
+  reader.getChar();
+  EXPECT_TRUE(reader.isEOF());
+  reader.reset(2);
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 1);
+  EXPECT_EQ(reader.getChar(), 'y');
+  reader.reset(0);
+  EXPECT_EQ(reader.getChar(), 'x');
+  EXPECT_THROW(reader.reset(text.size() + 1), std::runtime_error);
+}
+
+TEST(StringViewReaderTest, EmptyText) {
+  StringViewReader reader{std::string_view()};
+  EXPECT_EQ(reader.peekChar(0), '\0');
+  EXPECT_TRUE(reader.isEOF());
+  EXPECT_TRUE(reader.window().empty());
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 1);
+}
@@ -112,3 +112,156 @@ TEST(TwoBufferReaderTest, CheckLineColumn) {
 
   std::remove(path.c_str());
 }
+
+TEST(TwoBufferReaderTest, ReadsAcrossManyHalves) {
+  std::string text;
+  for (int i = 0; i < 1000; i++) {
+    text.push_back(static_cast<char>('a' + i % 26));
+  }
+  std::string path = writeTempFile(text, "test_many_halves.txt");
+  TwoBufferReader reader(path, 7);
+
+  std::string read;
+  while (true) {
+    char c = reader.getChar();
+    if (c == '\0') break;
+    read.push_back(c);
+  }
+  EXPECT_EQ(read, text);
+  EXPECT_TRUE(reader.isEOF());
+
+  std::remove(path.c_str());
+}
+
+TEST(TwoBufferReaderTest, PeekAcrossHalfBoundary) {
+  std::string text = "0123456789";
+  std::string path = writeTempFile(text, "test_peek_boundary.txt");
+  TwoBufferReader reader(path, 4);
+
+  EXPECT_EQ(reader.peekChar(3), '3');
+  EXPECT_EQ(reader.peekChar(4), '4');
+  EXPECT_EQ(reader.peekChar(7), '7');
+  EXPECT_EQ(reader.peekChar(9), '9');
+  EXPECT_EQ(reader.peekChar(10), '\0');
+  EXPECT_FALSE(reader.isEOF());
+
+  for (char expected : text) {
+    EXPECT_EQ(reader.peekChar(0), expected);
+    EXPECT_EQ(reader.getChar(), expected);
+  }
+  EXPECT_EQ(reader.peekChar(0), '\0');
+  EXPECT_TRUE(reader.isEOF());
+
+  std::remove(path.c_str());
+}
+
+TEST(TwoBufferReaderTest, FileSizeMultipleOfHalf) {
+  std::string text = "abcdefgh";
+  std::string path = writeTempFile(text, "test_exact_halves.txt");
+  TwoBufferReader reader(path, 4);
+
+  for (char expected : text) {
+    EXPECT_EQ(reader.getChar(), expected);
+  }
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+  EXPECT_EQ(reader.getLine(), 1);
+  EXPECT_EQ(reader.getColumn(), 9);
+
+  std::remove(path.c_str());
+}
+
+TEST(TwoBufferReaderTest, WindowAndAdvance) {
+  std::string text = "ab\ncdefg";
+  std::string path = writeTempFile(text, "test_window.txt");
+  TwoBufferReader reader(path, 4);
+
+  auto w = reader.window();
+  ASSERT_EQ(std::string(w.data(), w.size()), "ab\nc");
+  reader.advance(3);
+  EXPECT_EQ(reader.getLine(), 2);
+  EXPECT_EQ(reader.getColumn(), 1);
+
+  w = reader.window();
+  ASSERT_EQ(std::string(w.data(), w.size()), "c");
+  reader.advance(1);
+  EXPECT_EQ(reader.getColumn(), 2);
+
+  w = reader.window();
+  ASSERT_EQ(std::string(w.data(), w.size()), "defg");
+  reader.advance(2);
+  EXPECT_EQ(reader.getChar(), 'f');
+  EXPECT_EQ(reader.getColumn(), 5);
+
+  w = reader.window();
+  ASSERT_EQ(std::string(w.data(), w.size()), "g");
+  reader.advance(1);
+  EXPECT_TRUE(reader.window().empty());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+
+  std::remove(path.c_str());
+}
+
+TEST(TwoBufferReaderTest, MarkAndReset) {
+  std::string text;
+  for (int i = 0; i < 200; i++) {
+    text.push_back(static_cast<char>('a' + i % 26));
+  }
+  std::string path = writeTempFile(text, "test_mark_reset.txt");
+  TwoBufferReader reader(path, 8);
+
+  // Возврат внутри буфера: точка и текущая позиция в соседних половинах
+  reader.advance(5);
+  reader.mark();
+  for (int i = 0; i < 9; i++) {
+    reader.getChar();
+  }
+  reader.reset(7);
+  EXPECT_EQ(reader.getOffset(), 7u);
+  EXPECT_EQ(reader.getChar(), text[7]);
+
+  // От точки ушли дальше двух половин — нужная половина перечитывается
+  reader.mark();
+  for (int i = 0; i < 50; i++) {
+    reader.getChar();
+  }
+  reader.reset(10);
+  std::string rest;
+  while (true) {
+    char c = reader.getChar();
+    if (c == '\0') break;
+    rest.push_back(c);
+  }
+  EXPECT_EQ(rest, text.substr(10));
+  EXPECT_TRUE(reader.isEOF());
+
+  // После EOF возврат снимает признак конца файла
+  reader.mark();
+  reader.reset(text.size());
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_THROW(reader.reset(3), std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+TEST(TwoBufferReaderTest, NulInsideFileIsData) {
+  // '\0' посреди половины и последним байтом заполненной половины — данные, а не конец файла
+  const char raw[] = "ab\0\0cd\0e\0\0fgh\0";
+  std::string text(raw, sizeof(raw) - 1);
+  std::string path = writeTempFile(text, "test_nul_inside.txt");
+  TwoBufferReader reader(path, 4);
+
+  for (char expected : text) {
+    EXPECT_FALSE(reader.isEOF());
+    EXPECT_EQ(reader.getChar(), expected);
+  }
+  EXPECT_EQ(reader.getOffset(), text.size());
+  EXPECT_FALSE(reader.isEOF());
+  EXPECT_EQ(reader.getChar(), '\0');
+  EXPECT_TRUE(reader.isEOF());
+  EXPECT_EQ(reader.getOffset(), text.size());
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "../../Lexer/DFA/ConstexprDFA.h"
+#include "../../Lexer/TokenSpecification/TokenSpec.h"
+#include "../../SymbolTable/SymbolTable.h"
+#include "../../Lexer/Reader/TwoBufferReader.h"
+#include "../../Lexer/Reader/MmapReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Lexer/StaticDfaLexer.h"
+#include "TestDFA.h"
+
+static constexpr std::array<StaticTokenSpec, 2> IDENT_SPECS = {{
+        {"WHITESPACE", "[ \t\r\n]+", true},
+        {"IDENT", "[a-zA-Z]+", false},
+}};
+
+static constexpr std::array<StaticTokenSpec, 5> C_SPECS = {{
+        {"WHITESPACE", "[ \t\r\n]+", true},
+        {"OP", "([+]|[*]|[/]|[=][=]|[=]|[<][=]|[<]|[;]|[(]|[)]|[{]|[}])", false},
+        {"KEYWORD", "(if|else|while|return)", false},
+        {"NUMBER", "[0-9]+", false},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false},
+}};
+
+// Таблица вычисляется компилятором
+static constexpr auto IDENT_TABLE = makeStaticDFA<IDENT_SPECS>();
+static_assert(IDENT_TABLE.STATE_COUNT == 3);
+static_assert(IDENT_TABLE.next(IDENT_TABLE.startState, 'a') != -1);
+static_assert(IDENT_TABLE.next(IDENT_TABLE.startState, '1') == -1);
+static_assert(IDENT_TABLE.acceptToken[IDENT_TABLE.next(IDENT_TABLE.startState, 'Z')] == 1);
+static_assert(std::is_same_v<decltype(IDENT_TABLE)::StateId, int16_t>);
+
+// Минимальный DFA больше NFA (2^6 состояний): makeStaticDFA не хватает оценки ёмкости
+static constexpr std::array<StaticTokenSpec, 1> BLOWUP_SPECS = {{
+        {"TAIL", "[ab]*a[ab][ab][ab][ab][ab]", false},
+}};
+static constexpr auto BLOWUP_TABLE = makeStaticDFA<BLOWUP_SPECS>();
+static_assert(BLOWUP_TABLE.STATE_COUNT > staticDFAStateCapacity<BLOWUP_SPECS>());
+
+static std::vector<TokenSpec> toTokenSpecs(std::span<const StaticTokenSpec> specs) {
+  std::vector<TokenSpec> result;
+  for (size_t i = 0; i < specs.size(); i++) {
+    result.push_back({std::string(specs[i].name), std::string(specs[i].regex), specs[i].ignore, static_cast<int>(i)});
+  }
+  return result;
+}
+
+TEST(ConstexprDFATest, MatchesRuntimePipeline) {
+  DFA runtime = buildDFA(toTokenSpecs(C_SPECS));
+  DFA built = ConstexprDFABuilder::build(C_SPECS);
+  ASSERT_EQ(built.states.size(), runtime.states.size());
+  EXPECT_LE(built.classCount, runtime.classCount);
+  // Оба автомата минимальны, поэтому совпадают с точностью до нумерации: проверяем обходом
+  std::vector<int> mapping(runtime.states.size(), -1);
+  std::vector<std::pair<int, int>> stack = {{built.startState, runtime.startState}};
+  mapping[runtime.startState] = built.startState;
+  while (!stack.empty()) {
+    auto [b, r] = stack.back();
+    stack.pop_back();
+    ASSERT_EQ(built.states[b].isAccept, runtime.states[r].isAccept);
+    ASSERT_EQ(built.states[b].tokenIndex, runtime.states[r].tokenIndex);
+    for (int c = 0; c < 256; c++) {
+      int bt = built.next(b, static_cast<unsigned char>(c));
+      int rt = runtime.next(r, static_cast<unsigned char>(c));
+      ASSERT_EQ(bt == -1, rt == -1) << "byte " << c;
+      if (rt == -1) {
+        continue;
+      }
+      if (mapping[rt] == -1) {
+        mapping[rt] = bt;
+        stack.push_back({bt, rt});
+      }
+      ASSERT_EQ(mapping[rt], bt);
+    }
+  }
+}
+
+TEST(ConstexprDFATest, StaticTableCopiesToDFA) {
+  DFA dfa = IDENT_TABLE.toDFA();
+  ASSERT_EQ(dfa.states.size(), 3u);
+  int s = dfa.next(dfa.startState, 'q');
+  ASSERT_NE(s, -1);
+  EXPECT_TRUE(dfa.states[s].isAccept);
+  EXPECT_EQ(dfa.states[s].tokenIndex, 1);
+  EXPECT_EQ(dfa.next(dfa.startState, '7'), -1);
+}
+
+TEST(ConstexprDFATest, StaticTableLargerThanEstimate) {
+  DFA expected = ConstexprDFABuilder::build(BLOWUP_SPECS);
+  DFA dfa = BLOWUP_TABLE.toDFA();
+  ASSERT_EQ(dfa.states.size(), 64u);
+  ASSERT_EQ(dfa.states.size(), expected.states.size());
+  EXPECT_EQ(dfa.startState, expected.startState);
+  EXPECT_EQ(dfa.classCount, expected.classCount);
+  EXPECT_EQ(dfa.classOf, expected.classOf);
+  EXPECT_EQ(dfa.transitions, expected.transitions);
+  for (size_t i = 0; i < dfa.states.size(); i++) {
+    EXPECT_EQ(dfa.states[i].tokenIndex, expected.states[i].tokenIndex);
+  }
+}
+
+TEST(StaticDfaLexerTest, SimpleIdentifiers) {
+  std::string fileName = "tmp_static_lexer_test.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << "Hello World   Foo123";
+  }
+  SymbolTable symTable;
+  {
+    TwoBufferReader reader(fileName, 8);
+    StaticDfaLexer<IDENT_SPECS> lexer(reader, &symTable);
+
+    Token t1 = lexer.getNextToken();
+    EXPECT_EQ(t1.type, "IDENT");
+    EXPECT_EQ(t1.lexeme, "Hello");
+    EXPECT_EQ(t1.symbolId, 0);
+
+    Token t2 = lexer.getNextToken();
+    EXPECT_EQ(t2.type, "IDENT");
+    EXPECT_EQ(t2.lexeme, "World");
+
+    Token t3 = lexer.getNextToken();
+    EXPECT_EQ(t3.type, "IDENT");
+    EXPECT_EQ(t3.lexeme, "Foo");
+
+    for (const char *digit : {"1", "2", "3"}) {
+      Token t = lexer.getNextToken();
+      EXPECT_EQ(t.type, "UNKNOWN");
+      EXPECT_EQ(t.lexeme, digit);
+    }
+
+    Token eof = lexer.getNextToken();
+    EXPECT_EQ(eof.type, "END_OF_FILE");
+  }
+  std::remove(fileName.c_str());
+}
+
+TEST(StaticDfaLexerTest, MatchesDfaLexer) {
+  std::vector<TokenSpec> specs = toTokenSpecs(C_SPECS);
+  DFA dfa = buildDFA(specs);
+
+  std::string testInput;
+  for (int i = 0; i < 200; i++) {
+    testInput += "while (x_" + std::to_string(i) + " <= " + std::to_string(i * 7) + ") {";
+    testInput += (i % 5 == 0 ? "\n" : " ");
+    testInput += "if (a==b) return iffy; else y = y*2 + $;}\n";
+  }
+  std::string fileName = "tmp_static_lexer_compare.txt";
+  {
+    std::ofstream ofs(fileName);
+    ofs << testInput;
+  }
+
+  SymbolTable runtimeSymbols;
+  SymbolTable staticSymbols;
+  {
+    TwoBufferReader runtimeReader(fileName, 16);
+    MmapReader staticReader(fileName);
+    DfaLexer runtimeLexer(dfa, specs, runtimeReader, &runtimeSymbols);
+    StaticDfaLexer<C_SPECS> staticLexer(staticReader, &staticSymbols);
+    size_t count = 0;
+    while (true) {
+      CompactToken expected = runtimeLexer.getNextCompactToken();
+      CompactToken actual = staticLexer.getNextCompactToken();
+      ASSERT_EQ(actual.typeId, expected.typeId) << "token " << count;
+      ASSERT_EQ(actual.lexeme, expected.lexeme) << "token " << count;
+      ASSERT_EQ(actual.offset, expected.offset);
+      ASSERT_EQ(actual.line, expected.line);
+      ASSERT_EQ(actual.column, expected.column);
+      ASSERT_EQ(actual.symbolId, expected.symbolId);
+      if (expected.typeId == CompactToken::END_OF_FILE_TYPE) {
+        break;
+      }
+      count++;
+    }
+    EXPECT_GT(count, 1000u);
+    static_assert(StaticDfaLexer<C_SPECS>::staticTypeName(2) == "KEYWORD");
+    EXPECT_EQ(staticLexer.typeName(2), "KEYWORD");
+    EXPECT_EQ(staticLexer.typeName(CompactToken::END_OF_FILE_TYPE), "END_OF_FILE");
+  }
+  std::remove(fileName.c_str());
+}
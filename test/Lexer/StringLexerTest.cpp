@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "../../Lexer/TokenSpecification/TokenSpec.h"
+#include "../../Lexer/Reader/StringViewReader.h"
+#include "../../Lexer/DfaLexer.h"
+#include "../../Lexer/StringLexer.h"
+#include "../../SymbolTable/SymbolTable.h"
+#include "TestDFA.h"
+
+/// Число вызовов operator new в этом процессе
+static std::atomic<size_t> g_allocations{0};
+
+void *operator new(std::size_t size) {
+  g_allocations++;
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  std::free(p);
+}
+
+static const std::vector<TokenSpec> SPECS = {
+        {"WHITESPACE", "[ \t\r\n]+", true, 1},
+        {"COMMENT", "[/][*]([ -)+-~\t\r\n]|[*]+[ -)+-.0-~\t\r\n])*[*]+[/]", true, 2},
+        {"STRING", "[\"]([ !#-~])*[\"]", false, 3},
+        {"KEYWORD", "(int|return|while|if)", false, 4},
+        {"OP", "([+]|[-]|[*]|[/]|[=]|[<]|[;]|[,]|[.]|\\(|\\)|[{]|[}])", false, 5},
+        {"FLOAT", "[0-9]+[.][0-9]+", false, 6},
+        {"NUMBER", "[0-9]+", false, 7},
+        {"IDENT", "[a-zA-Z_][a-zA-Z0-9_]*", false, 8},
+};
+
+TEST(StringLexerTest, MatchesDfaLexerOverStringView) {
+  DFA dfa = buildDFA(SPECS);
+  std::string text;
+  for (int i = 0; i < 300; i++) {
+    text += "int x" + std::to_string(i % 17) + " = 3.25 * y; /* c\n c */ \"s\" @\n";
+  }
+  StringViewReader reader(text);
+  SymbolTable expectedSymbols;
+  DfaLexer lexer(dfa, SPECS, reader, &expectedSymbols);
+  TokenStream expected;
+  lexer.tokenizeAll(expected);
+
+  StringLexer stringLexer(dfa, SPECS);
+  SymbolTable symbols;
+  TokenStream actual;
+  EXPECT_EQ(stringLexer.tokenize(text, actual, &symbols), expected.size());
+  EXPECT_EQ(actual.source, text.data());
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(actual.typeIds[i], expected.typeIds[i]) << i;
+    ASSERT_EQ(actual.offsets[i], expected.offsets[i]) << i;
+    ASSERT_EQ(actual.lexeme(i), expected.lexeme(i)) << i;
+    ASSERT_EQ(actual.lines[i], expected.lines[i]) << i;
+    ASSERT_EQ(actual.columns[i], expected.columns[i]) << i;
+    ASSERT_EQ(actual.symbolIds[i], expected.symbolIds[i]) << i;
+  }
+}
+
+TEST(StringLexerTest, ReusedStreamDoesNotAllocate) {
+  DFA dfa = buildDFA(SPECS);
+  StringLexer lexer(dfa, SPECS);
+  const std::vector<std::string> snippets = {
+          "x = 1;", "while (a < b) { b = b - 1; }", "", "  /* only comment */  ",
+          "return \"str\" + 2.5;", "@#", "if(x)y=z;",
+  };
+  TokenStream out;
+  for (const auto &s : snippets) {
+    out.clear();
+    lexer.tokenize(s, out);
+  }
+  size_t before = g_allocations.load();
+  size_t tokens = 0;
+  for (int round = 0; round < 100; round++) {
+    for (const auto &s : snippets) {
+      out.clear();
+      tokens += lexer.tokenize(s, out);
+    }
+  }
+  EXPECT_EQ(g_allocations.load(), before);
+  EXPECT_GT(tokens, 0u);
+}
+
+TEST(StringLexerTest, ConvenienceOverloadAndNonEmptyOutput) {
+  DFA dfa = buildDFA(SPECS);
+  StringLexer lexer(dfa, SPECS);
+  const std::string text = "a\n  bb";
+  TokenStream tokens = lexer.tokenize(text);
+  ASSERT_EQ(tokens.size(), 2u);
+  EXPECT_EQ(tokens.lexeme(1), "bb");
+  EXPECT_EQ(tokens.lines[1], 2);
+  EXPECT_EQ(tokens.columns[1], 3);
+  EXPECT_THROW(lexer.tokenize(text, tokens), std::runtime_error);
+}
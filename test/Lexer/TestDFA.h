@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../../Lexer/DFA/DFA.h"
+#include "../../Lexer/DFA/DFABuiler.h"
+#include "../../Lexer/DFA/LexerDFABuilder.h"
+#include "../../Lexer/NFA/NFA.h"
+#include "../../Lexer/TokenSpecification/TokenSpec.h"
+
+/**
+ * @brief Спецификации T0, T1, ... по одной на выражение: токен i — regexes[i].
+ */
+inline std::vector<TokenSpec> specsOf(const std::vector<std::string> &regexes) {
+  std::vector<TokenSpec> specs;
+  for (size_t i = 0; i < regexes.size(); i++) {
+    specs.push_back({"T" + std::to_string(i), regexes[i], false, static_cast<int>(i)});
+  }
+  return specs;
+}
+
+/**
+ * @brief Объединённый NFA спецификаций (тот же конвейер, что в main: LexerDFABuilder).
+ */
+inline NFA buildNFA(const std::vector<TokenSpec> &specs) {
+  return LexerDFABuilder().buildNFA(specs);
+}
+
+/**
+ * @brief DFA после subset construction, без минимизации.
+ */
+inline DFA buildUnminimizedDFA(const std::vector<TokenSpec> &specs) {
+  SubsetConstructionDFABuilder dfaBuilder;
+  return dfaBuilder.buildFromNFA(buildNFA(specs));
+}
+
+/**
+ * @brief Минимальный DFA спецификаций — такой же, как строит main.
+ */
+inline DFA buildDFA(const std::vector<TokenSpec> &specs) {
+  return LexerDFABuilder().build(specs);
+}
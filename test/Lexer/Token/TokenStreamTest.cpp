@@ -0,0 +1,40 @@
+#include "../../../Lexer/Token/TokenStream.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <sys/mman.h>
+
+TEST(TokenStreamTest, PushCopiesLexemeWithoutSource) {
+  TokenStream stream;
+  std::string input = "int x";
+  stream.push({0, std::string_view(input).substr(0, 3), 0, 1, 1, -1});
+  stream.push({1, std::string_view(input).substr(4, 1), 4, 1, 5, 7});
+  input = "?????";
+  ASSERT_EQ(stream.size(), 2u);
+  EXPECT_EQ(stream.lexeme(0), "int");
+  EXPECT_EQ(stream.lexeme(1), "x");
+  EXPECT_EQ(stream.lengths[1], 1u);
+  EXPECT_EQ(stream.symbolIds[1], 7);
+}
+
+TEST(TokenStreamTest, LexemeLongerThan32BitsThrows) {
+  // Лексема длиннее UINT32_MAX байт: страницы только резервируются и не читаются
+  const size_t size = static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1;
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  ASSERT_NE(data, MAP_FAILED);
+  std::string_view huge(static_cast<const char *>(data), size);
+
+  EXPECT_EQ(TokenStream::lengthOf(huge.substr(0, size - 1)), std::numeric_limits<uint32_t>::max());
+  EXPECT_THROW(TokenStream::lengthOf(huge), std::runtime_error);
+
+  TokenStream stream;
+  stream.source = static_cast<const char *>(data);
+  EXPECT_THROW(stream.push({0, huge, 0, 1, 1, -1}), std::runtime_error);
+  EXPECT_TRUE(stream.empty());
+  EXPECT_TRUE(stream.lengths.empty());
+
+  munmap(data, size);
+}
@@ -1,9 +1,15 @@
 #include <fstream>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include "../../Preprocessor/GccPreprocessor.h"
 
+/**
+ * @brief Пишет content во временный файл, свой у каждого теста: под ctest -j тесты
+ *        идут параллельно и не должны перезаписывать вход друг друга.
+ */
 static std::string createTempFile(const std::string& content) {
-  const char* fileName = "test_temp_input.c";
+  std::string fileName = std::string("test_temp_input_") +
+                         ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".c";
   std::ofstream ofs(fileName);
   ofs << content;
   ofs.close();
@@ -17,6 +23,7 @@ TEST(GccPreprocessorTests, EmptyFile_ReturnsEmptyString) {
   std::string result = preprocessor.preprocessFile(fileName);
 
   EXPECT_TRUE(result.empty());
+  std::remove(fileName.c_str());
 }
 
 TEST(GccPreprocessorTests, LinesWithHash_Removed) {
@@ -38,6 +45,7 @@ TEST(GccPreprocessorTests, LinesWithHash_Removed) {
       EXPECT_NE('#', line[0]);
     }
   }
+  std::remove(fileName.c_str());
 }
 
 TEST(GccPreprocessorTests, MacroDefinition_ExpandsCorrectly) {
@@ -51,6 +59,7 @@ TEST(GccPreprocessorTests, MacroDefinition_ExpandsCorrectly) {
   std::string result = preprocessor.preprocessFile(fileName);
 
   EXPECT_NE(std::string::npos, result.find("123"));
+  std::remove(fileName.c_str());
 }
 
 TEST(GccPreprocessorTests, NonExistentFile_ThrowsException) {
@@ -62,3 +71,68 @@ TEST(GccPreprocessorTests, NonExistentFile_ThrowsException) {
                  auto out = preprocessor.preprocessFile(badFile);
                }, std::runtime_error);
 }
+
+TEST(GccPreprocessorTests, NonExistentFile_ReportsExitCodeNotWaitStatus) {
+  GccPreprocessor preprocessor;
+
+  try {
+    preprocessor.preprocessFile("DefinitelyNotExists_12345.c");
+    FAIL() << "preprocessFile() must throw for a missing file";
+  } catch (const std::runtime_error &e) {
+    // Тот же разбор статуса, что и у потока: код выхода gcc, а не 256
+    EXPECT_EQ(std::string(e.what()), "GCC return code is non-zero: 1");
+  }
+}
+
+/**
+ * @brief Читает весь вывод потока препроцессора.
+ */
+static std::string readStream(PreprocessorStream &stream) {
+  std::string result;
+  char buffer[256];
+  ssize_t n;
+  while ((n = ::read(stream.fd(), buffer, sizeof(buffer))) > 0) {
+    result.append(buffer, static_cast<size_t>(n));
+  }
+  return result;
+}
+
+TEST(GccPreprocessorTests, Stream_MatchesPreprocessFile) {
+  GccPreprocessor preprocessor;
+
+  std::string source = "#define N 3\n#pragma once\n";
+  for (int i = 0; i < 3000; i++) {
+    source += "int a" + std::to_string(i) + " = N;\n";
+  }
+  source += "int last";   // последняя строка без перевода строки
+  std::string fileName = createTempFile(source);
+
+  std::string expected = preprocessor.preprocessFile(fileName);
+  auto stream = preprocessor.openStream(fileName);
+  std::string streamed = readStream(*stream);
+  EXPECT_NO_THROW(stream->finish());
+  EXPECT_EQ(streamed, expected);
+  std::remove(fileName.c_str());
+}
+
+TEST(GccPreprocessorTests, Stream_NonExistentFile_ThrowsOnFinish) {
+  GccPreprocessor preprocessor;
+
+  auto stream = preprocessor.openStream("DefinitelyNotExists_12345.c");
+  readStream(*stream);
+  EXPECT_THROW(stream->finish(), std::runtime_error);
+}
+
+TEST(GccPreprocessorTests, Stream_ReportsExitCodeNotWaitStatus) {
+  GccPreprocessor preprocessor;
+
+  auto stream = preprocessor.openStream("DefinitelyNotExists_12345.c");
+  readStream(*stream);
+  try {
+    stream->finish();
+    FAIL() << "finish() must throw for a missing file";
+  } catch (const std::runtime_error &e) {
+    // gcc завершается с кодом 1; сырой статус waitpid был бы 256
+    EXPECT_EQ(std::string(e.what()), "GCC return code is non-zero: 1");
+  }
+}